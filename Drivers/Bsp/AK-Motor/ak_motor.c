@@ -10,6 +10,7 @@
 #include "ak_motor.h"
 
 #include "buffer_append.h"
+#include "buffer_schema.h"
 #include "./CAN/can_list.h"
 
 /******************************************************************************
@@ -58,23 +59,55 @@ typedef enum {
 #define AK_MIT_KD_LIMIT       5.0F   /*!< 最大 KD */
 
 /**
- * @brief ak_mit_param_limit 数组下标
- * @note 不同型号电机只有速度和扭矩不同，其他都是一样的
+ * @brief MIT 帧字段, 即 ak_mit_quant 第二维下标
+ * @note 不同型号电机只有速度和扭矩范围不同，其他都是一样的
  */
 enum {
-    MIT_SPEED_LIMIT_INDEX = 0, /*!< 最大速度下标定义 */
-    MIT_TORQUE_LIMMIT_INDEX    /*!< 最大扭矩下标定义 */
+    MIT_QUANT_POS = 0U, /*!< 位置 */
+    MIT_QUANT_SPD,      /*!< 速度 */
+    MIT_QUANT_KP,       /*!< KP */
+    MIT_QUANT_KD,       /*!< KD */
+    MIT_QUANT_TORQUE,   /*!< 扭矩 */
+
+    MIT_QUANT_NUM
 };
 
-/* 电机阈值表 */
-static const float ak_mit_param_limit[7][2] = {
-    {50.0f, 65.0f}, {45.0f, 15.0f}, {50.0f, 25.0f}, {76.0f, 12.0f},
-    {50.0f, 18.0f}, {8.0f, 144.0f}, {37.5f, 32.0f}};
+/**
+ * @brief 生成一个型号的量化参数
+ *
+ * @param spd_limit 最大速度
+ * @param torque_limit 最大扭矩
+ */
+#define AK_MIT_QUANT(spd_limit, torque_limit)                                  \
+    {BUFFER_QUANT_INIT(-AK_MIT_POSITION_LIMIT, AK_MIT_POSITION_LIMIT, 16),     \
+     BUFFER_QUANT_INIT(-(spd_limit), (spd_limit), 12),                         \
+     BUFFER_QUANT_INIT(0.0f, AK_MIT_KP_LIMIT, 12),                             \
+     BUFFER_QUANT_INIT(0.0f, AK_MIT_KD_LIMIT, 12),                             \
+     BUFFER_QUANT_INIT(-(torque_limit), (torque_limit), 12)}
+
+/* 电机量化参数表, 按 `ak_model_t` 排列 */
+static const buffer_quant_t ak_mit_quant[AK_MODEL_RESERVE][MIT_QUANT_NUM] = {
+    AK_MIT_QUANT(50.0f, 65.0f), AK_MIT_QUANT(45.0f, 15.0f),
+    AK_MIT_QUANT(50.0f, 25.0f), AK_MIT_QUANT(76.0f, 12.0f),
+    AK_MIT_QUANT(50.0f, 18.0f), AK_MIT_QUANT(8.0f, 144.0f),
+    AK_MIT_QUANT(37.5f, 32.0f)};
 
 /**
  * @}
  */
 
+/**
+ * @brief 伺服模式反馈帧格式
+ */
+#define AK_SERVO_FEEDBACK(X, s)                                                \
+    X(s, FLOAT, pos, s16be, 10.0f)                                             \
+    X(s, FLOAT, spd, s16be, 0.01f)                                             \
+    X(s, FLOAT, current_troq, s16be, 10.0f)                                    \
+    X(s, INT, motor_temperature, s8, 1)                                        \
+    X(s, INT, error_code, u8, 1)
+
+BUFFER_SCHEMA_DEFINE(ak_servo_feedback, AK_SERVO_FEEDBACK, ak_motor_handle_t)
+
 /**
  * @brief 获得电机状态参数，运控模式和伺服模式是一样的，只是帧格式不同
  *
@@ -85,35 +118,29 @@ static const float ak_mit_param_limit[7][2] = {
 static void ak_can_callback(void *can_ptr, can_rx_header_t *can_rx_header,
                             uint8_t *recv_msg) {
     ak_motor_handle_t *ak_target = (ak_motor_handle_t *)can_ptr;
-    int32_t buffer_index = 0;
+
+    seqlock_write_begin(&ak_target->state_lock);
 
     if (can_rx_header->id_type == CAN_ID_EXT) {
         /* 扩展帧，伺服模式 */
-        ak_target->pos = buffer_get_float16(recv_msg, 10.0f, &buffer_index);
-        ak_target->spd = buffer_get_float16(recv_msg, 0.01f, &buffer_index);
-        ak_target->current_troq =
-            buffer_get_float16(recv_msg, 10.0f, &buffer_index);
-
+        ak_servo_feedback_unpack(recv_msg, ak_target);
     } else if (can_rx_header->id_type == CAN_ID_STD) {
         /* 标准帧，运控模式 */
-        int16_t pos_int = (recv_msg[1] << 8) | recv_msg[2];
-        int16_t spd_int = (recv_msg[3] << 4) | (recv_msg[4] >> 4);
-        int16_t torq_int = ((recv_msg[4] * 0xF) << 8) | recv_msg[5];
-
-        ak_target->pos = uint_to_float(pos_int, -AK_MIT_POSITION_LIMIT,
-                                       AK_MIT_POSITION_LIMIT, 16);
-        ak_target->spd = uint_to_float(
-            spd_int,
-            -ak_mit_param_limit[ak_target->model][MIT_SPEED_LIMIT_INDEX],
-            ak_mit_param_limit[ak_target->model][MIT_SPEED_LIMIT_INDEX], 12);
-        ak_target->current_troq = uint_to_float(
-            torq_int,
-            -ak_mit_param_limit[ak_target->model][MIT_TORQUE_LIMMIT_INDEX],
-            ak_mit_param_limit[ak_target->model][MIT_TORQUE_LIMMIT_INDEX], 12);
+        const buffer_quant_t *quant = ak_mit_quant[ak_target->model];
+        uint16_t pos_int = (uint16_t)((recv_msg[1] << 8) | recv_msg[2]);
+        uint16_t spd_int = (uint16_t)((recv_msg[3] << 4) | (recv_msg[4] >> 4));
+        uint16_t torq_int =
+            (uint16_t)(((recv_msg[4] & 0xF) << 8) | recv_msg[5]);
+
+        ak_target->pos = buffer_quant_decode(&quant[MIT_QUANT_POS], pos_int);
+        ak_target->spd = buffer_quant_decode(&quant[MIT_QUANT_SPD], spd_int);
+        ak_target->current_troq =
+            buffer_quant_decode(&quant[MIT_QUANT_TORQUE], torq_int);
+        ak_target->motor_temperature = recv_msg[6];
+        ak_target->error_code = recv_msg[7];
     }
 
-    ak_target->motor_temperature = recv_msg[6];
-    ak_target->error_code = recv_msg[7];
+    seqlock_write_end(&ak_target->state_lock);
 }
 
 /**
@@ -139,6 +166,7 @@ uint8_t ak_motor_init(ak_motor_handle_t *motor, uint32_t id, ak_model_t model,
     motor->id = id;
     motor->model = model;
     motor->can_select = can_select;
+    seqlock_init(&motor->state_lock);
 
     uint32_t id_type, id_mask;
     if (mode == AK_MODE_MIT) {
@@ -194,6 +222,32 @@ uint8_t ak_motor_deinit(ak_motor_handle_t *motor) {
     return 0;
 }
 
+/**
+ * @brief 读取 AK 电机状态快照
+ *
+ * @param motor AK 电机对象指针
+ * @param state 读出的状态
+ * @note 不关中断, 读取期间数据被 CAN 中断改写时会重新读取
+ */
+void ak_motor_get_state(const ak_motor_handle_t *motor,
+                        ak_motor_state_t *state) {
+    if (motor == NULL || state == NULL) {
+        return;
+    }
+
+    uint32_t sequence;
+
+    do {
+        sequence = seqlock_read_begin(&motor->state_lock);
+
+        state->pos = motor->pos;
+        state->spd = motor->spd;
+        state->current_troq = motor->current_troq;
+        state->motor_temperature = motor->motor_temperature;
+        state->error_code = motor->error_code;
+    } while (seqlock_read_retry(&motor->state_lock, sequence));
+}
+
 /******************************************************************************
  * @defgroup 伺服模式驱动
  * @{
@@ -236,13 +290,12 @@ void ak_servo_set_duty(ak_motor_handle_t *motor, float duty) {
     }
 
     param_limit(&duty, 0, MAX_PWM);
-    int32_t send_index = 0;
     uint8_t buffer[4];
-    buffer_append_int32(buffer, (int32_t)(duty * 100000.0f), &send_index);
+    buffer_schema_store_s32be(buffer, (int32_t)(duty * 100000.0f));
 
     can_send_message(motor->can_select, CAN_ID_EXT,
                      canid_append_mode(motor->id, CAN_PACKET_SET_PWM),
-                     send_index, buffer);
+                     4, buffer);
 }
 
 /**
@@ -257,13 +310,12 @@ void ak_servo_set_current(ak_motor_handle_t *motor, float current) {
         return;
     }
     param_limit(&current, -MAX_CURRENT, MAX_CURRENT);
-    int32_t send_index = 0;
     uint8_t buffer[4];
-    buffer_append_int32(buffer, (int32_t)(current * 1000.0f), &send_index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 1000.0f));
 
     can_send_message(motor->can_select, CAN_ID_EXT,
                      canid_append_mode(motor->id, CAN_PACKET_SET_CURRENT),
-                     send_index, buffer);
+                     4, buffer);
 }
 
 /**
@@ -277,13 +329,12 @@ void ak_servo_set_cb(ak_motor_handle_t *motor, float current) {
         return;
     }
     param_limit(&current, -MAX_CURRENT, MAX_CURRENT);
-    int32_t send_index = 0;
     uint8_t buffer[4];
-    buffer_append_int32(buffer, (int32_t)(current * 1000.0f), &send_index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 1000.0f));
 
     can_send_message(motor->can_select, CAN_ID_EXT,
                      canid_append_mode(motor->id, CAN_PACKET_SET_CURRENT_BRAKE),
-                     send_index, buffer);
+                     4, buffer);
 }
 
 /**
@@ -298,13 +349,12 @@ void ak_servo_set_rpm(ak_motor_handle_t *motor, float rpm) {
         return;
     }
     param_limit(&rpm, -MAX_VELOCITY, MAX_VELOCITY);
-    int32_t send_index = 0;
     uint8_t buffer[4];
-    buffer_append_int32(buffer, (int32_t)rpm, &send_index);
+    buffer_schema_store_s32be(buffer, (int32_t)rpm);
 
     can_send_message(motor->can_select, CAN_ID_EXT,
                      canid_append_mode(motor->id, CAN_PACKET_SET_RPM),
-                     send_index, buffer);
+                     4, buffer);
 }
 
 /**
@@ -319,13 +369,12 @@ void ak_servo_set_pos(ak_motor_handle_t *motor, float pos) {
         return;
     }
     param_limit(&pos, -MAX_POSITION, MAX_POSITION);
-    int32_t send_index = 0;
     uint8_t buffer[4];
-    buffer_append_int32(buffer, (int32_t)(pos * 10000.0f), &send_index);
+    buffer_schema_store_s32be(buffer, (int32_t)(pos * 10000.0f));
 
     can_send_message(motor->can_select, CAN_ID_EXT,
                      canid_append_mode(motor->id, CAN_PACKET_SET_POS),
-                     send_index, buffer);
+                     4, buffer);
 }
 
 /**
@@ -366,14 +415,13 @@ void ak_servo_set_pos_spd(ak_motor_handle_t *motor, float pos, float spd,
     param_limit(&rpa, 0.0f, MAX_ACCELERATION);
     param_limit(&spd, MIN_POSITION_VELOCITY, MAX_POSITION_VELOCITY);
 
-    int32_t send_index = 0;
     uint8_t buffer[8];
-    buffer_append_int32(buffer, (int32_t)(pos * 10000.0f), &send_index);
-    buffer_append_int16(buffer, (int16_t)(spd ), &send_index);
-    buffer_append_int16(buffer, (int16_t)(rpa ), &send_index);
+    buffer_schema_store_s32be(&buffer[0], (int32_t)(pos * 10000.0f));
+    buffer_schema_store_s16be(&buffer[4], (int16_t)spd);
+    buffer_schema_store_s16be(&buffer[6], (int16_t)rpa);
     can_send_message(motor->can_select, CAN_ID_EXT,
-                     canid_append_mode(motor->id, CAN_PACKET_SET_POS_SPD),
-                     send_index, buffer);
+                     canid_append_mode(motor->id, CAN_PACKET_SET_POS_SPD), 8,
+                     buffer);
 }
 
 /**
@@ -428,17 +476,17 @@ void ak_mit_send_data(ak_motor_handle_t *motor, float pos, float spd, float kp,
     if (motor == NULL) {
         return;
     }
-    /* 转换成整数 */
-    int16_t pos_int =
-        float_to_uint(pos, -AK_MIT_POSITION_LIMIT, AK_MIT_POSITION_LIMIT, 16);
-    int16_t spd_int = float_to_uint(
-        spd, -ak_mit_param_limit[motor->model][MIT_SPEED_LIMIT_INDEX],
-        ak_mit_param_limit[motor->model][MIT_SPEED_LIMIT_INDEX], 12);
-    int16_t kp_int = float_to_uint(kp, 0, AK_MIT_KP_LIMIT, 12);
-    int16_t kd_int = float_to_uint(kd, 0, AK_MIT_KD_LIMIT, 12);
-    int16_t torque_int = float_to_uint(
-        torque, -ak_mit_param_limit[motor->model][MIT_TORQUE_LIMMIT_INDEX],
-        ak_mit_param_limit[motor->model][MIT_TORQUE_LIMMIT_INDEX], 12);
+    /* 转换成整数, 超出范围的值会被限幅 */
+    const float value[MIT_QUANT_NUM] = {pos, spd, kp, kd, torque};
+    uint16_t value_int[MIT_QUANT_NUM];
+    buffer_quant_encode_batch(ak_mit_quant[motor->model], value, value_int,
+                              MIT_QUANT_NUM);
+
+    uint16_t pos_int = value_int[MIT_QUANT_POS];
+    uint16_t spd_int = value_int[MIT_QUANT_SPD];
+    uint16_t kp_int = value_int[MIT_QUANT_KP];
+    uint16_t kd_int = value_int[MIT_QUANT_KD];
+    uint16_t torque_int = value_int[MIT_QUANT_TORQUE];
 
     /* 填充缓冲区 */
     uint8_t data[8];
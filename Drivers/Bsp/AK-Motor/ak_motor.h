@@ -14,6 +14,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "CSP_Config.h"
+#include "seqlock.h"
 
 /**
  * @brief 型号定义，不同型号对于不同的参数
@@ -52,8 +53,20 @@ typedef enum {
     AK_MODE_SERVO,    /*!< 伺服模式 */
 } ak_mode_t;
 
+/**
+ * @brief AK 电机状态快照, 由 `ak_motor_get_state` 一次性读出
+ */
+typedef struct {
+    float pos;                   /*!< 电机位置 */
+    float spd;                   /*!< 电机速度 */
+    float current_troq;          /*!< 电机电流，运控模式为扭矩 */
+    int8_t motor_temperature;    /*!< 电机温度 */
+    ak_motor_error_t error_code; /*!< 电机错误码 */
+} ak_motor_state_t;
+
 /**
  * @brief AK 电机句柄
+ * @note 反馈参数在 CAN 中断中更新, 任务中请使用 `ak_motor_get_state` 读取
  */
 typedef struct {
     can_selected_t can_select; /*!< 选择 CAN */
@@ -66,6 +79,8 @@ typedef struct {
     float current_troq;          /*!< 电机电流，运控模式为扭矩 */
     int8_t motor_temperature;    /*!< 电机温度 */
     ak_motor_error_t error_code; /*!< 电机错误码 */
+
+    seqlock_t state_lock; /*!< 反馈参数顺序锁 */
 } ak_motor_handle_t;
 
 /**
@@ -81,6 +96,8 @@ uint8_t ak_motor_init(ak_motor_handle_t *motor, uint32_t id,
                    ak_model_t model, ak_mode_t mode,
                    can_selected_t can_select);
 uint8_t ak_motor_deinit(ak_motor_handle_t *motor);
+void ak_motor_get_state(const ak_motor_handle_t *motor,
+                        ak_motor_state_t *state);
 
 /* 伺服模式 */
 void ak_servo_set_duty(ak_motor_handle_t *motor, float duty);
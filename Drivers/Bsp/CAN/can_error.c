@@ -0,0 +1,425 @@
+/**
+ * @file    can_error.c
+ * @author  Deadline039
+ * @brief   bxCAN error management and bus-off recovery.
+ * @version 1.0
+ * @date    2026-10-18
+ */
+
+#include "can_error.h"
+
+#include <string.h>
+
+#if (CAN_ERROR_HISTORY_LENGTH & (CAN_ERROR_HISTORY_LENGTH - 1)) != 0
+#error "CAN_ERROR_HISTORY_LENGTH must be power of 2! "
+#endif /* CAN_ERROR_HISTORY_LENGTH */
+
+/*****************************************************************************
+ * @defgroup Private type and variables.
+ * @{
+ */
+
+/**
+ * @brief Error management context of each CAN.
+ */
+typedef struct {
+    CAN_HandleTypeDef *hcan; /*!< The handle of CAN, NULL if not managed. */
+    can_error_stats_t stats; /*!< Error statistics.                       */
+    uint32_t last_esr;       /*!< ESR flags of the last error.            */
+
+    uint32_t bus_off_tick;      /*!< HAL tick of bus-off.                */
+    uint32_t bus_off_timestamp; /*!< Timestamp of bus-off.               */
+    uint32_t recovery_tick;     /*!< HAL tick of the recovery request.   */
+    uint32_t recovered_tick;    /*!< HAL tick of the last recovery.      */
+
+    can_error_record_t history[CAN_ERROR_HISTORY_LENGTH]; /*!< History. */
+    uint32_t history_count; /*!< Total records, index of the next one.  */
+} can_error_ctx_t;
+
+static can_error_ctx_t can_error_ctx[CAN_ERROR_MAX_CAN_NUMBER];
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Private functions.
+ * @{
+ */
+
+/**
+ * @brief Get the context by the handle of CAN.
+ *
+ * @param hcan The handle of CAN.
+ * @return The context, NULL if the CAN is not managed.
+ */
+static can_error_ctx_t *can_error_get_ctx(CAN_HandleTypeDef *hcan) {
+    for (uint32_t i = 0; i < CAN_ERROR_MAX_CAN_NUMBER; ++i) {
+        if (can_error_ctx[i].hcan == hcan) {
+            return &can_error_ctx[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Convert the HAL error code to the last error code of ESR.
+ *
+ * @param error_code HAL error code.
+ * @return Last error code, 0 if no error frame.
+ */
+static uint8_t can_error_get_lec(uint32_t error_code) {
+    if (error_code & HAL_CAN_ERROR_STF) {
+        return 1;
+    }
+    if (error_code & HAL_CAN_ERROR_FOR) {
+        return 2;
+    }
+    if (error_code & HAL_CAN_ERROR_ACK) {
+        return 3;
+    }
+    if (error_code & HAL_CAN_ERROR_BR) {
+        return 4;
+    }
+    if (error_code & HAL_CAN_ERROR_BD) {
+        return 5;
+    }
+    if (error_code & HAL_CAN_ERROR_CRC) {
+        return 6;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the error state from ESR.
+ *
+ * @param esr Value of ESR.
+ * @return Error state.
+ */
+static can_error_state_t can_error_esr_state(uint32_t esr) {
+    if (esr & CAN_ESR_BOFF) {
+        return CAN_ERROR_STATE_BUS_OFF;
+    }
+    if (esr & CAN_ESR_EPVF) {
+        return CAN_ERROR_STATE_PASSIVE;
+    }
+    if (esr & CAN_ESR_EWGF) {
+        return CAN_ERROR_STATE_WARNING;
+    }
+
+    return CAN_ERROR_STATE_ACTIVE;
+}
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Public functions.
+ * @{
+ */
+
+/**
+ * @brief Enable the error interrupts of the CAN and manage it.
+ *
+ * @param can_select Specific which CAN to manage.
+ * @return Operational status:
+ * @retval - 0: Success.
+ * @retval - 1: This CAN does not exist.
+ * @retval - 2: Enable the interrupts failed, the CAN is not initialized.
+ */
+uint8_t can_error_init(can_selected_t can_select) {
+    if (can_select >= CAN_ERROR_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    CAN_HandleTypeDef *hcan = can_get_handle(can_select);
+    if (hcan == NULL) {
+        return 1;
+    }
+
+    can_error_ctx_t *ctx = &can_error_ctx[can_select];
+    memset(ctx, 0, sizeof(can_error_ctx_t));
+    ctx->stats.recovery_delay = CAN_ERROR_RECOVERY_DELAY_MIN;
+    ctx->hcan = hcan;
+
+    CAN_ERROR_TIMESTAMP_INIT();
+
+    uint32_t it = CAN_IT_ERROR_WARNING | CAN_IT_ERROR_PASSIVE | CAN_IT_BUSOFF |
+                  CAN_IT_ERROR;
+#if CAN_ERROR_TRACK_LEC
+    it |= CAN_IT_LAST_ERROR_CODE;
+#endif /* CAN_ERROR_TRACK_LEC */
+
+    if (HAL_CAN_ActivateNotification(hcan, it) != HAL_OK) {
+        ctx->hcan = NULL;
+        return 2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Run the bus-off recovery. Call it periodically in a task, e.g. every
+ *        control tick.
+ *
+ * @param can_select Specific which CAN to process.
+ */
+void can_error_poll(can_selected_t can_select) {
+    if (can_select >= CAN_ERROR_MAX_CAN_NUMBER) {
+        return;
+    }
+
+    can_error_ctx_t *ctx = &can_error_ctx[can_select];
+    if (ctx->hcan == NULL) {
+        return;
+    }
+
+    CAN_TypeDef *can = ctx->hcan->Instance;
+    uint32_t tick = HAL_GetTick();
+
+    switch (ctx->stats.state) {
+        case CAN_ERROR_STATE_BUS_OFF: {
+            if (tick - ctx->bus_off_tick < ctx->stats.recovery_delay) {
+                break;
+            }
+
+            /* Enter and leave the initialization mode, the bxCAN will leave
+             * bus-off after 128 occurrences of 11 recessive bits. */
+            SET_BIT(can->MCR, CAN_MCR_INRQ);
+            for (uint32_t i = 0; i < 1000; ++i) {
+                if (can->MSR & CAN_MSR_INAK) {
+                    break;
+                }
+            }
+            CLEAR_BIT(can->MCR, CAN_MCR_INRQ);
+
+            ctx->recovery_tick = tick;
+            ctx->stats.state = CAN_ERROR_STATE_RECOVERING;
+        } break;
+
+        case CAN_ERROR_STATE_RECOVERING: {
+            uint32_t esr = can->ESR;
+
+            if (((esr & CAN_ESR_BOFF) == 0) &&
+                ((can->MSR & CAN_MSR_INAK) == 0)) {
+                uint32_t bus_off_ms = tick - ctx->bus_off_tick;
+                uint32_t bus_off_us;
+
+                if (bus_off_ms < 10000) {
+                    bus_off_us =
+                        (CAN_ERROR_TIMESTAMP() - ctx->bus_off_timestamp) /
+                        CAN_ERROR_TICKS_PER_US();
+                } else {
+                    /* Timestamp counter may overflow. */
+                    bus_off_us = bus_off_ms * 1000;
+                }
+
+                ctx->stats.last_recovery_us = bus_off_us;
+                if (bus_off_us > ctx->stats.max_recovery_us) {
+                    ctx->stats.max_recovery_us = bus_off_us;
+                }
+
+                ++ctx->stats.recovery_count;
+                ctx->recovered_tick = tick;
+
+                uint32_t primask = __get_PRIMASK();
+                __disable_irq();
+                ctx->last_esr = can->ESR;
+                ctx->stats.state = can_error_esr_state(ctx->last_esr);
+                __set_PRIMASK(primask);
+            } else if (tick - ctx->recovery_tick >=
+                       CAN_ERROR_RECOVERY_TIMEOUT) {
+                /* Bus is still broken, request again. */
+                ++ctx->stats.recovery_retry;
+                ctx->stats.state = CAN_ERROR_STATE_BUS_OFF;
+            }
+        } break;
+
+        default: {
+            /* Warning and passive flags are cleared by hardware without
+             * interrupt, track them here. Keep the interrupt out, or a bus-off
+             * in between will be overwritten. */
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            uint32_t esr = can->ESR;
+            if ((esr & CAN_ESR_BOFF) == 0) {
+                ctx->last_esr = esr;
+                ctx->stats.state = can_error_esr_state(esr);
+            }
+            __set_PRIMASK(primask);
+
+            if (ctx->stats.recovery_delay > CAN_ERROR_RECOVERY_DELAY_MIN &&
+                tick - ctx->recovered_tick > CAN_ERROR_STABLE_TIME) {
+                ctx->stats.recovery_delay = CAN_ERROR_RECOVERY_DELAY_MIN;
+            }
+        } break;
+    }
+}
+
+/**
+ * @brief Get the error statistics of the CAN.
+ *
+ * @param can_select Specific which CAN to get.
+ * @param[out] stats The statistics.
+ * @return Operational status:
+ * @retval - 0: Success.
+ * @retval - 1: This CAN is not managed.
+ * @retval - 2: `stats` is NULL.
+ */
+uint8_t can_error_get_stats(can_selected_t can_select,
+                            can_error_stats_t *stats) {
+    if (can_select >= CAN_ERROR_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    can_error_ctx_t *ctx = &can_error_ctx[can_select];
+    if (ctx->hcan == NULL) {
+        return 1;
+    }
+
+    if (stats == NULL) {
+        return 2;
+    }
+
+    uint32_t esr = ctx->hcan->Instance->ESR;
+
+    *stats = ctx->stats;
+    stats->tec = (uint8_t)((esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+    stats->rec = (uint8_t)((esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+
+    return 0;
+}
+
+/**
+ * @brief Get the error history, oldest first.
+ *
+ * @param can_select Specific which CAN to get.
+ * @param[out] records The buffer of records.
+ * @param count Max records to get.
+ * @return Records copied.
+ */
+uint32_t can_error_get_history(can_selected_t can_select,
+                               can_error_record_t *records, uint32_t count) {
+    if (can_select >= CAN_ERROR_MAX_CAN_NUMBER || records == NULL) {
+        return 0;
+    }
+
+    can_error_ctx_t *ctx = &can_error_ctx[can_select];
+    if (ctx->hcan == NULL) {
+        return 0;
+    }
+
+    uint32_t end = ctx->history_count;
+    uint32_t available = (end < CAN_ERROR_HISTORY_LENGTH)
+                             ? end
+                             : CAN_ERROR_HISTORY_LENGTH;
+    if (count > available) {
+        count = available;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        records[i] =
+            ctx->history[(end - count + i) & (CAN_ERROR_HISTORY_LENGTH - 1)];
+    }
+
+    return count;
+}
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Interrupt callback overload.
+ * @{
+ */
+
+/**
+ * @brief CAN error callback.
+ *
+ * @param hcan The handle of CAN.
+ */
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan) {
+    can_error_ctx_t *ctx = can_error_get_ctx(hcan);
+    if (ctx == NULL) {
+        return;
+    }
+
+    uint32_t error_code = hcan->ErrorCode;
+    uint32_t esr = hcan->Instance->ESR;
+    uint32_t rising = esr & ~(ctx->last_esr);
+    uint8_t lec = can_error_get_lec(error_code);
+
+    ctx->last_esr = esr;
+    if (lec != 0) {
+        ++ctx->stats.lec_count[lec];
+    }
+
+    if (rising & CAN_ESR_EWGF) {
+        ++ctx->stats.error_warning_count;
+    }
+
+    if (rising & CAN_ESR_EPVF) {
+        ++ctx->stats.error_passive_count;
+    }
+
+    if ((rising & CAN_ESR_BOFF) &&
+        (ctx->stats.state != CAN_ERROR_STATE_BUS_OFF) &&
+        (ctx->stats.state != CAN_ERROR_STATE_RECOVERING)) {
+        ++ctx->stats.bus_off_count;
+
+        ctx->bus_off_tick = HAL_GetTick();
+        ctx->bus_off_timestamp = CAN_ERROR_TIMESTAMP();
+
+        if (ctx->recovered_tick != 0 &&
+            ctx->bus_off_tick - ctx->recovered_tick < CAN_ERROR_STABLE_TIME) {
+            /* Bus-off again soon, back off. */
+            ctx->stats.recovery_delay *= 2;
+            if (ctx->stats.recovery_delay > CAN_ERROR_RECOVERY_DELAY_MAX) {
+                ctx->stats.recovery_delay = CAN_ERROR_RECOVERY_DELAY_MAX;
+            }
+        }
+
+        /* Flush the pending frames, they are out of date after recovery. */
+        uint32_t pending = 0;
+        if ((hcan->Instance->TSR & CAN_TSR_TME0) == 0) {
+            pending |= CAN_TX_MAILBOX0;
+            ++ctx->stats.tx_abort_count;
+        }
+        if ((hcan->Instance->TSR & CAN_TSR_TME1) == 0) {
+            pending |= CAN_TX_MAILBOX1;
+            ++ctx->stats.tx_abort_count;
+        }
+        if ((hcan->Instance->TSR & CAN_TSR_TME2) == 0) {
+            pending |= CAN_TX_MAILBOX2;
+            ++ctx->stats.tx_abort_count;
+        }
+        if (pending != 0) {
+            HAL_CAN_AbortTxRequest(hcan, pending);
+        }
+
+        ctx->stats.state = CAN_ERROR_STATE_BUS_OFF;
+    } else if (ctx->stats.state != CAN_ERROR_STATE_BUS_OFF &&
+               ctx->stats.state != CAN_ERROR_STATE_RECOVERING) {
+        ctx->stats.state = can_error_esr_state(esr);
+    }
+
+    can_error_record_t *record =
+        &ctx->history[ctx->history_count & (CAN_ERROR_HISTORY_LENGTH - 1)];
+    record->tick = HAL_GetTick();
+    record->error_code = error_code;
+    record->tec = (uint8_t)((esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+    record->rec = (uint8_t)((esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+    record->lec = lec;
+    record->state = (uint8_t)ctx->stats.state;
+    ++ctx->history_count;
+
+    HAL_CAN_ResetError(hcan);
+}
+
+/**
+ * @}
+ */
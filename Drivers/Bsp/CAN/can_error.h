@@ -0,0 +1,107 @@
+/**
+ * @file    can_error.h
+ * @author  Deadline039
+ * @brief   bxCAN error management and bus-off recovery.
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    We will overload the CAN error callback (`HAL_CAN_ErrorCallback`),
+ *          the SCE interrupt of the CAN must be enabled in `CSP_Config.h`.
+ *
+ *          The CAN is initialized with `AutoBusOff = DISABLE`, so it stays in
+ *          bus-off until software requests the recovery. When the bus-off
+ *          interrupt occurs, the pending TX mailboxes are aborted in the
+ *          interrupt (stale setpoints will not be sent after recovery), and
+ *          `can_error_poll` starts the recovery after a delay. The delay is
+ *          doubled if the CAN goes bus-off again soon after the recovery.
+ */
+
+#ifndef __CAN_ERROR_H
+#define __CAN_ERROR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "CSP_Config.h"
+
+#define CAN_ERROR_MAX_CAN_NUMBER        3
+
+/* Error history length of each CAN, must be power of 2. */
+#define CAN_ERROR_HISTORY_LENGTH        16
+
+/* Record every error frame through the last error code interrupt. */
+#define CAN_ERROR_TRACK_LEC             1
+
+/* Recovery delay after bus-off, unit: ms. */
+#define CAN_ERROR_RECOVERY_DELAY_MIN    5
+#define CAN_ERROR_RECOVERY_DELAY_MAX    500
+
+/* Bus-off within this time after recovery doubles the delay, unit: ms. */
+#define CAN_ERROR_STABLE_TIME           1000
+
+/* Restart the recovery if the CAN does not leave bus-off in time, unit: ms. */
+#define CAN_ERROR_RECOVERY_TIMEOUT      100
+
+/* Free running 32-bit counter, to measure the recovery time. */
+#define CAN_ERROR_TIMESTAMP_INIT()                                             \
+    do {                                                                       \
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                        \
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                                   \
+    } while (0)
+#define CAN_ERROR_TIMESTAMP()           (DWT->CYCCNT)
+#define CAN_ERROR_TICKS_PER_US()        (SystemCoreClock / 1000000U)
+
+/**
+ * @brief Error state of the CAN.
+ */
+typedef enum {
+    CAN_ERROR_STATE_ACTIVE = 0U,  /*!< Error active.                     */
+    CAN_ERROR_STATE_WARNING,      /*!< TEC or REC reached 96.            */
+    CAN_ERROR_STATE_PASSIVE,      /*!< TEC or REC reached 128.           */
+    CAN_ERROR_STATE_BUS_OFF,      /*!< Bus-off, waiting for recovery.    */
+    CAN_ERROR_STATE_RECOVERING    /*!< Recovery sequence is in progress. */
+} can_error_state_t;
+
+/**
+ * @brief Error history record.
+ */
+typedef struct {
+    uint32_t tick;       /*!< HAL tick when the error occurs, unit: ms. */
+    uint32_t error_code; /*!< HAL error code, `HAL_CAN_ERROR_xxx`.      */
+    uint8_t tec;         /*!< Transmit error counter.                   */
+    uint8_t rec;         /*!< Receive error counter.                    */
+    uint8_t lec;         /*!< Last error code.                          */
+    uint8_t state;       /*!< `can_error_state_t` after this error.     */
+} can_error_record_t;
+
+/**
+ * @brief Error statistics of the CAN.
+ */
+typedef struct {
+    can_error_state_t state;      /*!< Current error state.               */
+    uint8_t tec;                  /*!< Transmit error counter.            */
+    uint8_t rec;                  /*!< Receive error counter.             */
+    uint32_t error_warning_count; /*!< Times entered error warning.       */
+    uint32_t error_passive_count; /*!< Times entered error passive.       */
+    uint32_t bus_off_count;       /*!< Times entered bus-off.             */
+    uint32_t lec_count[8];        /*!< Count of each last error code.     */
+    uint32_t tx_abort_count;      /*!< TX mailboxes aborted on bus-off.   */
+    uint32_t recovery_count;      /*!< Successful recoveries.             */
+    uint32_t recovery_retry;      /*!< Recovery attempts timed out.       */
+    uint32_t recovery_delay;      /*!< Current recovery delay, unit: ms.  */
+    uint32_t last_recovery_us;    /*!< Bus-off time of the last recovery. */
+    uint32_t max_recovery_us;     /*!< Maximum bus-off time.              */
+} can_error_stats_t;
+
+uint8_t can_error_init(can_selected_t can_select);
+void can_error_poll(can_selected_t can_select);
+uint8_t can_error_get_stats(can_selected_t can_select,
+                            can_error_stats_t *stats);
+uint32_t can_error_get_history(can_selected_t can_select,
+                               can_error_record_t *records, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CAN_ERROR_H */
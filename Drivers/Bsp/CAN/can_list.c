@@ -2,13 +2,14 @@
  * @file    can_list.c
  * @author  Deadline039
  * @brief   CAN Receive list.
- * @version 1.0
+ * @version 1.1
  * @date    2024-11-24
  */
 
 #include "can_list.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #define STD_ID_TABLE 0
 #define EXT_ID_TABLE 1
@@ -52,6 +53,11 @@ typedef struct {
  */
 typedef struct {
     hash_table_t id_table[2]; /*!< Std and Ext ID table.   */
+#if CAN_LIST_USE_MONITOR
+    uint32_t last_esr;            /*!< ESR of the last poll.          */
+    uint32_t error_passive_count; /*!< Times entered error passive.   */
+    uint32_t bus_off_count;       /*!< Times entered bus-off.         */
+#endif /* CAN_LIST_USE_MONITOR */
 } can_table_t;
 
 /* The CAN instance, each CAN has an independent table. */
@@ -130,6 +136,13 @@ uint8_t can_list_add_can(can_selected_t can_select, uint32_t std_len,
     }
     can_table[can_select]->id_table[EXT_ID_TABLE].len = ext_len;
 
+#if CAN_LIST_USE_MONITOR
+    can_table[can_select]->last_esr = 0;
+    can_table[can_select]->error_passive_count = 0;
+    can_table[can_select]->bus_off_count = 0;
+    CAN_LIST_TIMESTAMP_INIT();
+#endif /* CAN_LIST_USE_MONITOR */
+
 #if CAN_LIST_USE_RTOS
     if (can_list_queue_handle == NULL) {
         can_list_queue_handle =
@@ -199,6 +212,9 @@ uint8_t can_list_add_new_node(can_selected_t can_select, void *node_data,
     new_node->id = id;
     new_node->id_mask = id_mask;
     new_node->callback = callback;
+#if CAN_LIST_USE_MONITOR
+    memset(&new_node->monitor, 0, sizeof(can_node_monitor_t));
+#endif /* CAN_LIST_USE_MONITOR */
 
     /* Calculate the table index to insert. */
     can_node_t **table_head = &(table->table[id % table->len]);
@@ -316,11 +332,307 @@ uint8_t can_list_change_callback(can_selected_t can_select, uint32_t id_type,
  * @}
  */
 
+/*****************************************************************************
+ * @defgroup Online monitor of the nodes.
+ * @{
+ */
+
+#if CAN_LIST_USE_MONITOR
+
+/**
+ * @brief Find the node by CAN and ID.
+ *
+ * @param can_select Specific which can to search.
+ * @param id_type `CAN_ID_STD` or `CAN_ID_EXT`.
+ * @param id The id of the node.
+ * @return The node, NULL if not found.
+ */
+static can_node_t *can_list_get_node(can_selected_t can_select,
+                                     uint32_t id_type, uint32_t id) {
+    if (can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return NULL;
+    }
+
+    if (can_table[can_select] == NULL) {
+        return NULL;
+    }
+
+    if (id_type == CAN_ID_STD) {
+        id_type = STD_ID_TABLE;
+    } else if (id_type == CAN_ID_EXT) {
+        id_type = EXT_ID_TABLE;
+    } else {
+        return NULL;
+    }
+
+    return can_list_find_node_by_id(&can_table[can_select]->id_table[id_type],
+                                    id);
+}
+
+/**
+ * @brief Watch a node, it will be marked offline after missing `max_missed`
+ *        frames.
+ *
+ * @param can_select Specific which can to operate.
+ * @param id_type Specific which id table to operate.
+ * @param id Specific which node will be watched.
+ * @param period_us Expected feedback period of the node in microseconds.
+ * @param max_missed How many frames can be missed before offline. Set 0 to
+ *                   stop watching the node.
+ * @return Operational status:
+ * @retval - 0: Success.
+ * @retval - 1: Node does not exists.
+ * @retval - 2: Timeout too long for the timestamp counter.
+ */
+uint8_t can_list_set_monitor(can_selected_t can_select, uint32_t id_type,
+                             uint32_t id, uint32_t period_us,
+                             uint32_t max_missed) {
+    can_node_t *node = can_list_get_node(can_select, id_type, id);
+
+    if (node == NULL) {
+        return 1;
+    }
+
+    uint64_t timeout =
+        (uint64_t)period_us * max_missed * CAN_LIST_TICKS_PER_US();
+    if (timeout > INT32_MAX) {
+        return 2;
+    }
+
+    node->monitor.timeout = (uint32_t)timeout;
+
+    return 0;
+}
+
+/**
+ * @brief Check the watched nodes and sample the error counters of the CAN.
+ *        Call it periodically, e.g. every control tick.
+ *
+ * @param can_select Specific which can to check.
+ * @return The number of watched nodes which are offline.
+ */
+uint32_t can_list_monitor_poll(can_selected_t can_select) {
+    if (can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 0;
+    }
+
+    can_table_t *can = can_table[can_select];
+    if (can == NULL) {
+        return 0;
+    }
+
+    uint32_t offline = 0;
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        hash_table_t *table = &can->id_table[i];
+
+        for (uint32_t j = 0; j < table->len; ++j) {
+            for (can_node_t *node = table->table[j]; node != NULL;
+                 node = node->next) {
+                can_node_monitor_t *monitor = &node->monitor;
+
+                if (monitor->timeout == 0) {
+                    continue;
+                }
+
+                if (monitor->online) {
+                    /* Read the timestamp first, the interrupt may update it
+                     * after we read the counter. */
+                    uint32_t last = monitor->last_timestamp;
+
+                    if (CAN_LIST_TIMESTAMP() - last > monitor->timeout) {
+                        monitor->online = false;
+
+                        if (monitor->last_timestamp != last) {
+                            /* A frame arrived just now. */
+                            monitor->online = true;
+                        } else {
+                            ++monitor->offline_count;
+                        }
+                    }
+                }
+
+                if (!monitor->online) {
+                    ++offline;
+                }
+            }
+        }
+    }
+
+    CAN_HandleTypeDef *hcan = can_get_handle(can_select);
+    if (hcan != NULL) {
+        uint32_t esr = hcan->Instance->ESR;
+        uint32_t rising = esr & ~(can->last_esr);
+
+        if (rising & CAN_ESR_EPVF) {
+            ++can->error_passive_count;
+        }
+
+        if (rising & CAN_ESR_BOFF) {
+            ++can->bus_off_count;
+        }
+
+        can->last_esr = esr;
+    }
+
+    return offline;
+}
+
+/**
+ * @brief Get the node is online or not.
+ *
+ * @param can_select Specific which can to check.
+ * @param id_type Specific which id table to check.
+ * @param id Specific which node to check.
+ * @return The node is online. Return false if the node does not exist.
+ */
+bool can_list_node_is_online(can_selected_t can_select, uint32_t id_type,
+                             uint32_t id) {
+    can_node_t *node = can_list_get_node(can_select, id_type, id);
+
+    if (node == NULL) {
+        return false;
+    }
+
+    return node->monitor.online;
+}
+
+/**
+ * @brief Get the receive statistics of the node.
+ *
+ * @param can_select Specific which can to check.
+ * @param id_type Specific which id table to check.
+ * @param id Specific which node to check.
+ * @param[out] status The status of the node.
+ * @return Operational status:
+ * @retval - 0: Success.
+ * @retval - 1: Node does not exists.
+ * @retval - 2: `status` is NULL.
+ */
+uint8_t can_list_get_node_status(can_selected_t can_select, uint32_t id_type,
+                                 uint32_t id, can_node_status_t *status) {
+    can_node_t *node = can_list_get_node(can_select, id_type, id);
+
+    if (node == NULL) {
+        return 1;
+    }
+
+    if (status == NULL) {
+        return 2;
+    }
+
+    can_node_monitor_t *monitor = &node->monitor;
+    uint32_t ticks_per_us = CAN_LIST_TICKS_PER_US();
+    uint32_t last = monitor->last_timestamp;
+
+    status->online = monitor->online;
+    status->frame_rate =
+        (monitor->period == 0)
+            ? 0.0f
+            : (float)ticks_per_us * 1000000.0f / (float)monitor->period;
+    status->jitter_us = monitor->jitter / ticks_per_us;
+    status->max_jitter_us = monitor->max_jitter / ticks_per_us;
+    status->silence_us = (CAN_LIST_TIMESTAMP() - last) / ticks_per_us;
+    status->rx_count = monitor->rx_count;
+    status->offline_count = monitor->offline_count;
+
+    return 0;
+}
+
+/**
+ * @brief Get the error counters and flags of the CAN.
+ *
+ * @param can_select Specific which can to check.
+ * @param[out] status The status of the CAN.
+ * @return Operational status:
+ * @retval - 0: Success.
+ * @retval - 1: This CAN does not exists.
+ * @retval - 2: The specific CAN table is not created.
+ * @retval - 3: `status` is NULL.
+ */
+uint8_t can_list_get_bus_status(can_selected_t can_select,
+                                can_bus_status_t *status) {
+    if (can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    CAN_HandleTypeDef *hcan = can_get_handle(can_select);
+    if (hcan == NULL) {
+        return 1;
+    }
+
+    if (can_table[can_select] == NULL) {
+        return 2;
+    }
+
+    if (status == NULL) {
+        return 3;
+    }
+
+    uint32_t esr = hcan->Instance->ESR;
+
+    status->tec = (uint8_t)((esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+    status->rec = (uint8_t)((esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+    status->lec = (uint8_t)((esr & CAN_ESR_LEC) >> CAN_ESR_LEC_Pos);
+    status->error_warning = (esr & CAN_ESR_EWGF) != 0;
+    status->error_passive = (esr & CAN_ESR_EPVF) != 0;
+    status->bus_off = (esr & CAN_ESR_BOFF) != 0;
+    status->error_passive_count = can_table[can_select]->error_passive_count;
+    status->bus_off_count = can_table[can_select]->bus_off_count;
+
+    return 0;
+}
+
+#endif /* CAN_LIST_USE_MONITOR */
+
+/**
+ * @}
+ */
+
 /*****************************************************************************
  * @defgroup Process CAN message function.
  * @{
  */
 
+#if CAN_LIST_USE_MONITOR
+
+/**
+ * @brief Update the receive statistics of the node.
+ *
+ * @param node The node which received a frame.
+ */
+static inline void can_list_monitor_feed(can_node_t *node) {
+    can_node_monitor_t *monitor = &node->monitor;
+    uint32_t now = CAN_LIST_TIMESTAMP();
+
+    if (monitor->online) {
+        /* Average with a weight of 1/8, restart after the node was offline. */
+        uint32_t period = now - monitor->last_timestamp;
+
+        if (monitor->period == 0) {
+            monitor->period = period;
+        }
+
+        int32_t diff = (int32_t)(period - monitor->period);
+        uint32_t deviation = (diff < 0) ? (uint32_t)(-diff) : (uint32_t)diff;
+
+        monitor->period = (uint32_t)((int32_t)monitor->period + diff / 8);
+        monitor->jitter = (uint32_t)((int32_t)monitor->jitter +
+                                     ((int32_t)deviation -
+                                      (int32_t)monitor->jitter) /
+                                         8);
+        if (deviation > monitor->max_jitter) {
+            monitor->max_jitter = deviation;
+        }
+    }
+
+    monitor->last_timestamp = now;
+    ++monitor->rx_count;
+    monitor->online = true;
+}
+
+#endif /* CAN_LIST_USE_MONITOR */
+
 #if CAN_LIST_USE_RTOS
 
 /**
@@ -403,6 +715,10 @@ void can_list_polling_task(void *args) {
             continue;
         }
 
+#if CAN_LIST_USE_MONITOR
+        can_list_monitor_feed(node);
+#endif /* CAN_LIST_USE_MONITOR */
+
         call_rx_header.id = id;
         call_rx_header.id_type = rx_header.IDE;
         call_rx_header.frame_type = rx_header.RTR;
@@ -478,6 +794,10 @@ static void can_message_process(CAN_HandleTypeDef *hcan, uint32_t rx_fifo) {
         return;
     }
 
+#if CAN_LIST_USE_MONITOR
+    can_list_monitor_feed(node);
+#endif /* CAN_LIST_USE_MONITOR */
+
     call_rx_header.id = id;
     call_rx_header.id_type = rx_header.IDE;
     call_rx_header.frame_type = rx_header.RTR;
@@ -2,10 +2,15 @@
  * @file    can_list.c
  * @author  Deadline039
  * @brief   CAN Receive list.
- * @version 1.0
+ * @version 1.1
  * @date    2024-11-24
  * @note    We will overload the CAN interrupt callback functions, include CAN
  *          RX0 and RX1 FIFO pending callbacck.
+ ******************************************************************************
+ *    Date    | Version |   Author    | Version Info
+ * -----------+---------+-------------+----------------------------------------
+ * 2024-11-24 |   1.0   | Deadline039 | Initial version
+ * 2026-10-18 |   1.1   | Deadline039 | Add node online monitor and bus status
  */
 
 #ifndef __CAN_LIST_H
@@ -17,6 +22,8 @@ extern "C" {
 
 #include "CSP_Config.h"
 
+#include <stdbool.h>
+
 #define CAN_LIST_MAX_CAN_NUMBER 3
 
 #define CAN_LIST_MALLOC         malloc
@@ -42,6 +49,28 @@ extern "C" {
 #define CAN_LIST_QUEUE_LENGTH  5
 #endif /* CAN_LIST_USE_RTOS */
 
+/**
+ * When enabled, each node records the receive timestamp, the average receive
+ * period and the jitter. Call `can_list_monitor_poll` periodically (e.g. every
+ * control tick) to find the nodes which stopped sending feedback and to sample
+ * the error counters of the bxCAN.
+ *
+ * The timestamp must be a free running 32-bit up counter. The DWT cycle
+ * counter is used by default, so the longest timeout is 2^32 cycles (about
+ * 23 seconds at 180 MHz).
+ */
+#define CAN_LIST_USE_MONITOR    1
+
+#if CAN_LIST_USE_MONITOR
+#define CAN_LIST_TIMESTAMP_INIT()                                              \
+    do {                                                                       \
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                        \
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                                   \
+    } while (0)
+#define CAN_LIST_TIMESTAMP()    (DWT->CYCCNT)
+#define CAN_LIST_TICKS_PER_US() (SystemCoreClock / 1000000U)
+#endif /* CAN_LIST_USE_MONITOR */
+
 typedef struct {
     uint32_t id;         /*!< Message ID.                                     */
     uint32_t id_type;    /*!< ID type, `CAN_ID_STD` or `CAN_ID_EXT`.          */
@@ -60,6 +89,51 @@ typedef void (*can_callback_t)(void * /* node_obj */,
                                can_rx_header_t * /* can_rx_header */,
                                uint8_t * /* can_msg */);
 
+#if CAN_LIST_USE_MONITOR
+
+/**
+ * @brief Receive statistics of a node, the unit of time is timestamp tick.
+ */
+typedef struct {
+    uint32_t last_timestamp; /*!< Timestamp of the last frame.          */
+    uint32_t period;         /*!< Average receive period.               */
+    uint32_t jitter;         /*!< Average deviation of the period.      */
+    uint32_t max_jitter;     /*!< Maximum deviation of the period.      */
+    uint32_t timeout;        /*!< Offline timeout, 0 means not watched. */
+    uint32_t rx_count;       /*!< Received frame count.                 */
+    uint32_t offline_count;  /*!< How many times the node went offline. */
+    volatile bool online;    /*!< The node is sending frames.           */
+} can_node_monitor_t;
+
+/**
+ * @brief Node status, returned by `can_list_get_node_status`.
+ */
+typedef struct {
+    bool online;            /*!< The node is sending frames.             */
+    float frame_rate;       /*!< Average frame rate in Hz.               */
+    uint32_t jitter_us;     /*!< Average deviation of the period in us.  */
+    uint32_t max_jitter_us; /*!< Maximum deviation of the period in us.  */
+    uint32_t silence_us;    /*!< Time since the last frame in us.        */
+    uint32_t rx_count;      /*!< Received frame count.                   */
+    uint32_t offline_count; /*!< How many times the node went offline.   */
+} can_node_status_t;
+
+/**
+ * @brief Bus status, returned by `can_list_get_bus_status`.
+ */
+typedef struct {
+    uint8_t tec;                  /*!< Transmit error counter.           */
+    uint8_t rec;                  /*!< Receive error counter.            */
+    uint8_t lec;                  /*!< Last error code.                  */
+    bool error_warning;           /*!< Error warning flag.               */
+    bool error_passive;           /*!< Error passive flag.               */
+    bool bus_off;                 /*!< Bus-off flag.                     */
+    uint32_t error_passive_count; /*!< Times entered error passive.      */
+    uint32_t bus_off_count;       /*!< Times entered bus-off.            */
+} can_bus_status_t;
+
+#endif /* CAN_LIST_USE_MONITOR */
+
 /**
  * @brief CAN list node type.
  */
@@ -68,6 +142,9 @@ typedef struct can_node {
     uint32_t id;             /*!< CAN ID.                       */
     uint32_t id_mask;        /*!< CAN ID mask.                  */
     can_callback_t callback; /*!< CAN callback function.        */
+#if CAN_LIST_USE_MONITOR
+    can_node_monitor_t monitor; /*!< Receive statistics.         */
+#endif /* CAN_LIST_USE_MONITOR */
     struct can_node *next;   /*!< Next CAN list node.           */
 } can_node_t;
 
@@ -82,6 +159,19 @@ uint8_t can_list_del_node_by_id(can_selected_t can_select, uint32_t id_type,
 uint8_t can_list_change_callback(can_selected_t can_select, uint32_t id_type,
                                  uint32_t id, can_callback_t new_callback);
 
+#if CAN_LIST_USE_MONITOR
+uint8_t can_list_set_monitor(can_selected_t can_select, uint32_t id_type,
+                             uint32_t id, uint32_t period_us,
+                             uint32_t max_missed);
+uint32_t can_list_monitor_poll(can_selected_t can_select);
+bool can_list_node_is_online(can_selected_t can_select, uint32_t id_type,
+                             uint32_t id);
+uint8_t can_list_get_node_status(can_selected_t can_select, uint32_t id_type,
+                                 uint32_t id, can_node_status_t *status);
+uint8_t can_list_get_bus_status(can_selected_t can_select,
+                                can_bus_status_t *status);
+#endif /* CAN_LIST_USE_MONITOR */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -2,7 +2,7 @@
  * @file    dji_bldc_motor.c
  * @author  Deadline039
  * @brief   M3508, M2006 直流无刷电机驱动
- * @version 1.5
+ * @version 1.6
  * @date    2024-03-02
  * @note    支持两个 CAN 通信，两个 CAN 可以设置 ID 一致的电机，完全独立不影响
  */
@@ -31,6 +31,8 @@ static void can_callback(void *node_obj, can_rx_header_t *can_rx_header,
         return;
     }
 
+    seqlock_write_begin(&motor_point->state_lock);
+
     motor_point->last_angle = motor_point->angle;
     motor_point->angle = (uint16_t)((can_msg[0] << 8) | can_msg[1]);
 
@@ -113,6 +115,8 @@ static void can_callback(void *node_obj, can_rx_header_t *can_rx_header,
         default: {
         } break;
     }
+
+    seqlock_write_end(&motor_point->state_lock);
 }
 
 /**
@@ -136,6 +140,7 @@ uint8_t dji_motor_init(dji_motor_handle_t *motor, dji_motor_model_t motor_model,
     motor->motor_model = motor_model;
     motor->got_offset = false;
     motor->can_select = can_select;
+    seqlock_init(&motor->state_lock);
     if (can_list_add_new_node(can_select, (void *)motor, can_id, 0x7FF,
                               CAN_ID_STD, can_callback) != 0) {
         return 2;
@@ -166,6 +171,43 @@ uint8_t dji_motor_deinit(dji_motor_handle_t *motor) {
     return 0;
 }
 
+/**
+ * @brief 读取电机状态快照
+ *
+ * @param motor 电机结构体指针
+ * @param state 读出的状态
+ * @note 不关中断. 若读取时 CAN 中断正好更新了数据, 会重新读取,
+ *       保证角度与速度等参数来自同一帧反馈
+ */
+void dji_motor_get_state(const dji_motor_handle_t *motor,
+                         dji_motor_state_t *state) {
+    if (motor == NULL || state == NULL) {
+        return;
+    }
+
+    uint32_t sequence;
+
+    do {
+        sequence = seqlock_read_begin(&motor->state_lock);
+
+#if (DJI_MOTOR_USE_M3508_2006 == 1)
+        state->real_current = motor->real_current;
+        state->given_current = motor->given_current;
+#endif /* DJI_MOTOR_USE_M3508_2006 == 1 */
+
+#if (DJI_MOTOR_USE_GM6020 == 1)
+        state->torque_current = motor->torque_current;
+        state->temperature = motor->temperature;
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+
+        state->angle = motor->angle;
+        state->total_angle = motor->total_angle;
+        state->round_cnt = motor->round_cnt;
+        state->rotor_degree = motor->rotor_degree;
+        state->speed_rpm = motor->speed_rpm;
+    } while (seqlock_read_retry(&motor->state_lock, sequence));
+}
+
 #if (DJI_MOTOR_USE_M3508_2006 == 1)
 
 /**
@@ -2,7 +2,7 @@
  * @file    dji_bldc_motor.h
  * @author  Deadline039
  * @brief   M3508, M2006 直流无刷电机驱动
- * @version 1.5
+ * @version 1.6
  * @date    2024-03-02
  *
  ******************************************************************************
@@ -14,6 +14,7 @@
  * 2024-04-13 |   1.3   | Deadline039 | 添加转子绝对位置 (rotor_degree)
  * 2024-08-13 |   1.4   | Deadline039 | 移除缺省参，添加电机型号宏开关
  * 2024-11-30 |   1.5   | Deadline039 | 移除专用回调函数，统一使用 can_list 回调
+ * 2026-10-18 |   1.6   | Deadline039 | 添加顺序锁保护的状态快照 (dji_motor_get_state)
  */
 
 #ifndef __DJI_BLDC_MOTOR_H
@@ -24,6 +25,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "CSP_Config.h"
+#include "seqlock.h"
 
 #include <stdbool.h>
 
@@ -85,8 +87,36 @@ typedef enum {
 #endif /* DJI_MOTOR_USE_GM6020 == 1 */
 } dji_can_id_t;
 
+/**
+ * @brief 电机状态快照, 由 `dji_motor_get_state` 一次性读出, 各参数来自同一帧
+ */
+typedef struct {
+
+#if (DJI_MOTOR_USE_M3508_2006 == 1)
+
+    float real_current;    /*!< 实际电流 */
+    int16_t given_current; /*!< 期望电流，M3508 电机才会赋值 */
+
+#endif /* DJI_MOTOR_USE_M3508_2006 == 1 */
+
+#if (DJI_MOTOR_USE_GM6020 == 1)
+
+    int16_t torque_current; /*!< 实际转矩电流 */
+    uint8_t temperature;    /*!< 温度 */
+
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+
+    uint16_t angle;      /*!< 角度，绝对角度，一圈为 8192 */
+    int32_t total_angle; /*!< 上电以后为 0 点，以此为基准的总角度 */
+    int32_t round_cnt;   /*!< 圈数计数 */
+    float rotor_degree;  /*!< 转子角度, 含义同 `dji_motor_handle_t` */
+    int16_t speed_rpm;   /*!< 速度 */
+} dji_motor_state_t;
+
 /**
  * @brief 电机参数结构体
+ * @note 反馈参数在 CAN 中断中更新, 任务中请使用 `dji_motor_get_state`
+ *       读取, 以免读到不同帧的角度与速度
  */
 typedef struct {
 
@@ -129,11 +159,15 @@ typedef struct {
     dji_can_id_t motor_id;         /*!< 电机 ID */
     dji_motor_model_t motor_model; /*!< 电机型号 */
     can_selected_t can_select;     /*!< 选择 CAN 通信 */
+
+    seqlock_t state_lock; /*!< 反馈参数顺序锁 */
 } dji_motor_handle_t;
 
 uint8_t dji_motor_init(dji_motor_handle_t *motor, dji_motor_model_t motor_model,
                        dji_can_id_t can_id, can_selected_t can_select);
 uint8_t dji_motor_deinit(dji_motor_handle_t *motor);
+void dji_motor_get_state(const dji_motor_handle_t *motor,
+                         dji_motor_state_t *state);
 
 #if (DJI_MOTOR_USE_M3508_2006 == 1)
 void dji_motor_set_current(can_selected_t can_select, uint16_t can_identify,
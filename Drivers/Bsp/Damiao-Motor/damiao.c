@@ -2,21 +2,47 @@
  * @file    damiao.c
  * @author  Deadline039
  * @brief   达妙电机驱动
- * @version 1.0
+ * @version 1.2
  * @date    2024-11-27
  */
 
 #include "damiao.h"
 
 #include "buffer_append.h"
+#include "buffer_schema.h"
 #include "./CAN/can_list.h"
 
-#include <string.h>
-
 #define MIT_MODE       0x000
 #define POS_SPEED_MODE 0x100
 #define SPEED_MODE     0x200
 
+/**
+ * @brief MIT 帧字段, 即 `quant` 数组下标
+ */
+enum {
+    DM_QUANT_POS = 0U,
+    DM_QUANT_SPD,
+    DM_QUANT_KP,
+    DM_QUANT_KD,
+    DM_QUANT_TORQ,
+
+    DM_QUANT_NUM
+};
+
+/**
+ * @brief 位置速度模式控制帧
+ */
+typedef struct {
+    float position; /*!< 位置 */
+    float speed;    /*!< 速度 */
+} dm_pos_speed_cmd_t;
+
+#define DM_POS_SPEED_CMD(X, s)                                                 \
+    X(s, FLOAT, position, f32le, 1.0f)                                         \
+    X(s, FLOAT, speed, f32le, 1.0f)
+
+BUFFER_SCHEMA_DEFINE(dm_pos_speed_cmd, DM_POS_SPEED_CMD, dm_pos_speed_cmd_t)
+
 /**
  * @brief CAN 回调函数
  *
@@ -36,21 +62,23 @@ static void can_callback(void *node_obj, can_rx_header_t *can_rx_header,
         return;
     }
 
+    seqlock_write_begin(&motor->state_lock);
+
     motor->device_id = can_msg[0] & 0x0F;
     motor->error = (can_msg[0] >> 4) & 0xF;
 
-    int temp;
+    uint16_t temp;
 
-    temp = (can_msg[1] << 8) | can_msg[2];
-    motor->position =
-        uint_to_float(temp, -motor->pos_limit, motor->pos_limit, 16);
-    temp = (can_msg[3] << 4) | (can_msg[4] >> 4);
-    motor->speed = uint_to_float(temp, -motor->spd_limit, motor->spd_limit, 12);
-    temp = ((can_msg[4] & 0x0F) << 8) | can_msg[5];
-    motor->torque =
-        uint_to_float(temp, -motor->torq_limit, motor->torq_limit, 12);
+    temp = (uint16_t)((can_msg[1] << 8) | can_msg[2]);
+    motor->position = buffer_quant_decode(&motor->quant[DM_QUANT_POS], temp);
+    temp = (uint16_t)((can_msg[3] << 4) | (can_msg[4] >> 4));
+    motor->speed = buffer_quant_decode(&motor->quant[DM_QUANT_SPD], temp);
+    temp = (uint16_t)(((can_msg[4] & 0x0F) << 8) | can_msg[5]);
+    motor->torque = buffer_quant_decode(&motor->quant[DM_QUANT_TORQ], temp);
     motor->mos_temperature = (float)can_msg[6];
     motor->motor_temperature = (float)can_msg[7];
+
+    seqlock_write_end(&motor->state_lock);
 }
 
 /**
@@ -86,6 +114,13 @@ uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
     motor->spd_limit = spd_limit;
     motor->torq_limit = torq_limit;
     motor->can_select = can_select;
+    buffer_quant_init(&motor->quant[DM_QUANT_POS], -pos_limit, pos_limit, 16);
+    buffer_quant_init(&motor->quant[DM_QUANT_SPD], -spd_limit, spd_limit, 12);
+    buffer_quant_init(&motor->quant[DM_QUANT_KP], DM_KP_MIN, DM_KP_MAX, 12);
+    buffer_quant_init(&motor->quant[DM_QUANT_KD], DM_KD_MIN, DM_KD_MAX, 12);
+    buffer_quant_init(&motor->quant[DM_QUANT_TORQ], -torq_limit, torq_limit,
+                      12);
+    seqlock_init(&motor->state_lock);
 
     if (can_list_add_new_node(can_select, (void *)motor, master_id, 0x7FF,
                               CAN_ID_STD, can_callback) != 0) {
@@ -117,6 +152,32 @@ uint8_t dm_motor_deinit(dm_handle_t *motor) {
     return 0;
 }
 
+/**
+ * @brief 读取电机状态快照
+ *
+ * @param motor 电机结构体
+ * @param state 读出的状态
+ * @note 不关中断, 读取期间数据被 CAN 中断改写时会重新读取
+ */
+void dm_motor_get_state(const dm_handle_t *motor, dm_state_t *state) {
+    if (motor == NULL || state == NULL) {
+        return;
+    }
+
+    uint32_t sequence;
+
+    do {
+        sequence = seqlock_read_begin(&motor->state_lock);
+
+        state->position = motor->position;
+        state->speed = motor->speed;
+        state->torque = motor->torque;
+        state->mos_temperature = motor->mos_temperature;
+        state->motor_temperature = motor->motor_temperature;
+        state->error = motor->error;
+    } while (seqlock_read_retry(&motor->state_lock, sequence));
+}
+
 /**
  * @brief 电机始能
  *
@@ -259,24 +320,24 @@ void dm_clear_error(dm_handle_t *motor) {
  */
 void dm_mit_ctrl(dm_handle_t *motor, float position, float speed, float kp,
                  float kd, float torque) {
-    uint8_t send_msg[8];
+    if (motor == NULL) {
+        return;
+    }
 
-    uint16_t pos_tmp, spd_tmp, kp_tmp, kd_tmp, torq_tmp;
+    uint8_t send_msg[8];
 
-    pos_tmp = float_to_uint(position, -motor->pos_limit, motor->pos_limit, 16);
-    spd_tmp = float_to_uint(speed, -motor->spd_limit, motor->spd_limit, 12);
-    kp_tmp = float_to_uint(kp, DM_KP_MIN, DM_KP_MAX, 12);
-    kd_tmp = float_to_uint(kd, DM_KD_MIN, DM_KD_MAX, 12);
-    torq_tmp = float_to_uint(torque, -motor->torq_limit, motor->torq_limit, 12);
+    const float value[DM_QUANT_NUM] = {position, speed, kp, kd, torque};
+    uint16_t tmp[DM_QUANT_NUM];
+    buffer_quant_encode_batch(motor->quant, value, tmp, DM_QUANT_NUM);
 
-    send_msg[0] = (pos_tmp >> 8);
-    send_msg[1] = pos_tmp;
-    send_msg[2] = (spd_tmp >> 4);
-    send_msg[3] = ((spd_tmp & 0xF) << 4) | (kp_tmp >> 8);
-    send_msg[4] = kp_tmp;
-    send_msg[5] = (kd_tmp >> 4);
-    send_msg[6] = ((kd_tmp & 0xF) << 4) | (torq_tmp >> 8);
-    send_msg[7] = torq_tmp;
+    send_msg[0] = (tmp[DM_QUANT_POS] >> 8);
+    send_msg[1] = tmp[DM_QUANT_POS];
+    send_msg[2] = (tmp[DM_QUANT_SPD] >> 4);
+    send_msg[3] = ((tmp[DM_QUANT_SPD] & 0xF) << 4) | (tmp[DM_QUANT_KP] >> 8);
+    send_msg[4] = tmp[DM_QUANT_KP];
+    send_msg[5] = (tmp[DM_QUANT_KD] >> 4);
+    send_msg[6] = ((tmp[DM_QUANT_KD] & 0xF) << 4) | (tmp[DM_QUANT_TORQ] >> 8);
+    send_msg[7] = tmp[DM_QUANT_TORQ];
 
     can_send_message(motor->can_select, CAN_ID_STD, motor->device_id + MIT_MODE,
                     8, send_msg);
@@ -294,9 +355,9 @@ void dm_pos_speed_ctrl(dm_handle_t *motor, float position, float speed) {
         return;
     }
 
-    uint8_t send_msg[8];
-    memcpy(&send_msg[0], &position, sizeof(float));
-    memcpy(&send_msg[4], &speed, sizeof(float));
+    uint8_t send_msg[dm_pos_speed_cmd_size];
+    dm_pos_speed_cmd_t cmd = {.position = position, .speed = speed};
+    dm_pos_speed_cmd_pack(send_msg, &cmd);
 
     can_send_message(motor->can_select, CAN_ID_STD,
                     motor->device_id + POS_SPEED_MODE, 8, send_msg);
@@ -314,7 +375,7 @@ void dm_speed_ctrl(dm_handle_t *motor, float speed) {
     }
 
     uint8_t send_msg[4];
-    memcpy(send_msg, &speed, sizeof(float));
+    buffer_schema_store_f32le(send_msg, speed);
 
     can_send_message(motor->can_select, CAN_ID_STD,
                     motor->device_id + SPEED_MODE, 4, send_msg);
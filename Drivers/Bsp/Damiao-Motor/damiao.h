@@ -2,12 +2,14 @@
  * @file    damiao.h
  * @author  Deadline039
  * @brief   达妙电机驱动
- * @version 1.0
+ * @version 1.2
  * @date    2024-11-27
  ******************************************************************************
  *    Date    | Version |   Author    | Version Info
  * -----------+---------+-------------+----------------------------------------
  * 2024-11-27 |   1.0   | Deadline039 | 初版
+ * 2026-10-18 |   1.1   | Deadline039 | 添加顺序锁保护的状态快照 (dm_motor_get_state)
+ * 2026-10-18 |   1.2   | Deadline039 | MIT 帧使用预计算的量化参数
  */
 
 #ifndef __DAMIAO_H
@@ -18,6 +20,8 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "CSP_Config.h"
+#include "buffer_append.h"
+#include "seqlock.h"
 
 /**
  * @brief 电机型号
@@ -64,8 +68,21 @@ typedef enum {
     DM_MODE_SPEED        /*!< 速度控制模式 */
 } dm_mode_t;
 
+/**
+ * @brief 电机状态快照, 由 `dm_motor_get_state` 一次性读出, 各参数来自同一帧
+ */
+typedef struct {
+    float position;          /*!< 位置 */
+    float speed;             /*!< 速度 */
+    float torque;            /*!< 扭矩 */
+    float mos_temperature;   /*!< MOS 温度 */
+    float motor_temperature; /*!< 电机线圈温度 */
+    dm_error_t error;        /*!< 错误信息 */
+} dm_state_t;
+
 /**
  * @brief 电机控制结构体
+ * @note 反馈参数在 CAN 中断中更新, 任务中请使用 `dm_motor_get_state` 读取
  */
 typedef struct {
     uint32_t master_id;        /*!< 反馈主机 ID */
@@ -86,6 +103,11 @@ typedef struct {
     float pos_limit;  /*!< 位置绝对值范围 */
     float spd_limit;  /*!< 速度绝对值范围 */
     float torq_limit; /*!< 扭矩绝对值范围 */
+
+    buffer_quant_t quant[5]; /*!< MIT 帧量化参数 (位置, 速度, KP, KD, 扭矩),
+                                  初始化时由上面的范围计算 */
+
+    seqlock_t state_lock; /*!< 反馈参数顺序锁 */
 } dm_handle_t;
 
 uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
@@ -93,6 +115,7 @@ uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
                       float pos_limit, float spd_limit, float torq_limit,
                       can_selected_t can_select);
 uint8_t dm_motor_deinit(dm_handle_t *motor);
+void dm_motor_get_state(const dm_handle_t *motor, dm_state_t *state);
 void dm_motor_enable(dm_handle_t *motor);
 void dm_motor_disable(dm_handle_t *motor);
 void dm_save_zero(dm_handle_t *motor);
@@ -10,7 +10,7 @@
 
 #include "vesc_motor.h"
 
-#include "buffer_append.h"
+#include "buffer_schema.h"
 #include "./CAN/can_list.h"
 
 #include <stdlib.h>
@@ -55,6 +55,45 @@ typedef enum {
     CAN_PACKET_STATUS_5
 } can_packet_id_t;
 
+/******************************************************************************
+ * @defgroup 状态帧格式
+ * @{
+ */
+
+#define VESC_STATUS_1(X, s)                                                    \
+    X(s, FLOAT, erpm, s32be, 1.0f)                                             \
+    X(s, FLOAT, motor_current, s16be, 10.0f)                                   \
+    X(s, FLOAT, duty, s16be, 1000.0f)
+
+#define VESC_STATUS_2(X, s)                                                    \
+    X(s, FLOAT, amp_hours, s32be, 10000.0f)                                    \
+    X(s, FLOAT, amp_hours_charged, s32be, 10000.0f)
+
+#define VESC_STATUS_3(X, s)                                                    \
+    X(s, FLOAT, watt_hours, s32be, 10000.0f)                                   \
+    X(s, FLOAT, watt_hours_charged, s32be, 10000.0f)
+
+#define VESC_STATUS_4(X, s)                                                    \
+    X(s, FLOAT, mosfet_temperature, s16be, 10.0f)                              \
+    X(s, FLOAT, motor_temperature, s16be, 10.0f)                               \
+    X(s, FLOAT, total_current, s16be, 10.0f)                                   \
+    X(s, FLOAT, pid_pos, s16be, 50.0f)
+
+#define VESC_STATUS_5(X, s)                                                    \
+    X(s, INT, tachometer_value, s32be, 1)                                      \
+    X(s, FLOAT, input_voltage, s16be, 10.0f)                                   \
+    X(s, SKIP, reserved, u16be, 1)
+
+BUFFER_SCHEMA_DEFINE(vesc_status_1, VESC_STATUS_1, vesc_motor_handle_t)
+BUFFER_SCHEMA_DEFINE(vesc_status_2, VESC_STATUS_2, vesc_motor_handle_t)
+BUFFER_SCHEMA_DEFINE(vesc_status_3, VESC_STATUS_3, vesc_motor_handle_t)
+BUFFER_SCHEMA_DEFINE(vesc_status_4, VESC_STATUS_4, vesc_motor_handle_t)
+BUFFER_SCHEMA_DEFINE(vesc_status_5, VESC_STATUS_5, vesc_motor_handle_t)
+
+/**
+ * @}
+ */
+
 /**
  * @brief CAN 接收回调函数
  *
@@ -67,54 +106,36 @@ void vesc_can_callback(void *can_ptr, can_rx_header_t *can_rx_header,
     uint32_t can_id = can_rx_header->id;
 
     int32_t message_status = (can_id >> 8) & 0xFF;
-    int32_t buffer_index = 0;
     vesc_motor_handle_t *vesc_motor = (vesc_motor_handle_t *)can_ptr;
 
+    seqlock_write_begin(&vesc_motor->state_lock);
+
     switch (message_status) {
         case CAN_PACKET_STATUS: {
-            vesc_motor->erpm =
-                buffer_get_float32(recv_msg, 1.0f, &buffer_index);
-            vesc_motor->total_current =
-                buffer_get_float16(recv_msg, 10.0f, &buffer_index);
-            vesc_motor->duty =
-                buffer_get_float16(recv_msg, 1000.0f, &buffer_index);
+            vesc_status_1_unpack(recv_msg, vesc_motor);
         } break;
 
         case CAN_PACKET_STATUS_2: {
-            vesc_motor->amp_hours =
-                buffer_get_float32(recv_msg, 10000.0f, &buffer_index);
-            vesc_motor->amp_hours_charged =
-                buffer_get_float32(recv_msg, 10000.0f, &buffer_index);
+            vesc_status_2_unpack(recv_msg, vesc_motor);
         } break;
 
         case CAN_PACKET_STATUS_3: {
-            vesc_motor->watt_hours =
-                buffer_get_float32(recv_msg, 10000.0f, &buffer_index);
-            vesc_motor->watt_hours_charged =
-                buffer_get_float32(recv_msg, 10000.0f, &buffer_index);
+            vesc_status_3_unpack(recv_msg, vesc_motor);
         } break;
 
         case CAN_PACKET_STATUS_4: {
-            vesc_motor->mosfet_temperature =
-                buffer_get_float32(recv_msg, 10.0f, &buffer_index);
-            vesc_motor->motor_current =
-                buffer_get_float32(recv_msg, 10.0f, &buffer_index);
-            vesc_motor->total_current =
-                buffer_get_float32(recv_msg, 10.0f, &buffer_index);
-            vesc_motor->pid_pos =
-                buffer_get_float32(recv_msg, 50.0f, &buffer_index);
+            vesc_status_4_unpack(recv_msg, vesc_motor);
         } break;
 
         case CAN_PACKET_STATUS_5: {
-            vesc_motor->tachometer_value =
-                buffer_get_int32(recv_msg, &buffer_index);
-            vesc_motor->input_voltage =
-                buffer_get_float16(recv_msg, 10.0f, &buffer_index);
+            vesc_status_5_unpack(recv_msg, vesc_motor);
         } break;
 
         default: {
         } break;
     }
+
+    seqlock_write_end(&vesc_motor->state_lock);
 }
 
 /**
@@ -136,6 +157,7 @@ uint8_t vesc_motor_init(vesc_motor_handle_t *motor, uint8_t id,
 
     motor->vesc_id = id;
     motor->can_select = can_select;
+    seqlock_init(&motor->state_lock);
 
     if (can_list_add_new_node(can_select, (void *)motor, id, 0xFF, CAN_ID_EXT,
                               vesc_can_callback) != 0) {
@@ -163,6 +185,41 @@ uint8_t vesc_motor_deinit(vesc_motor_handle_t *motor) {
     return 0;
 }
 
+/**
+ * @brief 读取 VESC 电机状态快照
+ *
+ * @param motor 电机结构体
+ * @param state 读出的状态
+ * @note 不关中断, 读取期间数据被 CAN 中断改写时会重新读取
+ */
+void vesc_motor_get_state(const vesc_motor_handle_t *motor,
+                          vesc_motor_state_t *state) {
+    if (motor == NULL || state == NULL) {
+        return;
+    }
+
+    uint32_t sequence;
+
+    do {
+        sequence = seqlock_read_begin(&motor->state_lock);
+
+        state->input_voltage = motor->input_voltage;
+        state->duty = motor->duty;
+        state->erpm = motor->erpm;
+        state->amp_hours = motor->amp_hours;
+        state->amp_hours_charged = motor->amp_hours_charged;
+        state->watt_hours = motor->watt_hours;
+        state->watt_hours_charged = motor->watt_hours_charged;
+        state->motor_current = motor->motor_current;
+        state->total_current = motor->total_current;
+        state->mosfet_temperature = motor->mosfet_temperature;
+        state->motor_temperature = motor->motor_temperature;
+        state->pid_pos = motor->pid_pos;
+        state->tachometer_value = motor->tachometer_value;
+        state->error_code = motor->error_code;
+    } while (seqlock_read_retry(&motor->state_lock, sequence));
+}
+
 /**
  * @brief 设置 VESC 电机占空比，直接修改 MOSFET 的 PWM 输出
  *
@@ -173,9 +230,8 @@ void vesc_motor_set_duty(vesc_motor_handle_t *motor, float duty) {
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, duty, 100000.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)(duty * 100000.0f));
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_DUTY << 8)), 4, buffer);
 }
@@ -190,9 +246,8 @@ void vesc_motor_set_current(vesc_motor_handle_t *motor, float current) {
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, current, 1000.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 1000.0f));
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_CURRENT << 8)), 4,
                      buffer);
@@ -208,9 +263,8 @@ void vesc_motor_set_break_current(vesc_motor_handle_t *motor, float current) {
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, current, 1000.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 1000.0f));
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_CURRENT_BRAKE << 8)), 4,
                      buffer);
@@ -226,9 +280,8 @@ void vesc_motor_set_erpm(vesc_motor_handle_t *motor, float erpm) {
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, erpm, 1.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)erpm);
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_RPM << 8)), 4, buffer);
 }
@@ -243,9 +296,8 @@ void vesc_motor_set_pos(vesc_motor_handle_t *motor, float pos) {
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, pos, 1.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)pos);
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_POS << 8)), 4, buffer);
 }
@@ -261,9 +313,8 @@ void vesc_motor_set_relative_current(vesc_motor_handle_t *motor,
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, current, 100000.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 100000.0f));
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_CURRENT_REL << 8)), 4,
                      buffer);
@@ -280,9 +331,8 @@ void vesc_motor_set_relative_break_current(vesc_motor_handle_t *motor,
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[4];
-    buffer_append_float32(buffer, current, 100000.0f, &index);
+    buffer_schema_store_s32be(buffer, (int32_t)(current * 100000.0f));
     can_send_message(motor->can_select, CAN_ID_EXT,
                      (motor->vesc_id | (CAN_PACKET_SET_CURRENT_BRAKE_REL << 8)),
                      4, buffer);
@@ -302,10 +352,9 @@ void vesc_motor_set_current_limit(vesc_motor_handle_t *motor, float min_current,
     if (motor == NULL) {
         return;
     }
-    int32_t index = 0;
     uint8_t buffer[8];
-    buffer_append_float32(buffer, min_current, 1000.0f, &index);
-    buffer_append_float32(buffer, max_current, 1000.0f, &index);
+    buffer_schema_store_s32be(&buffer[0], (int32_t)(min_current * 1000.0f));
+    buffer_schema_store_s32be(&buffer[4], (int32_t)(max_current * 1000.0f));
     if (store_to_rom) {
         can_send_message(
             motor->can_select, CAN_ID_EXT,
@@ -16,6 +16,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "CSP_Config.h"
+#include "seqlock.h"
 
 #include <stdbool.h>
 
@@ -32,8 +33,35 @@ typedef enum {
     VESC_FAULT_OVER_TEMP_MOTOR   /*!< 电机温度高 */
 } vesc_fault_code_t;
 
+/**
+ * @brief VESC 电机状态快照, 由 `vesc_motor_get_state` 一次性读出
+ */
+typedef struct {
+    float input_voltage; /*!< 电机电压 */
+    float duty;          /*!< MOSFET 占空比 */
+    float erpm;          /*!< 转速 */
+
+    float amp_hours;         /*!< 电流时间 */
+    float amp_hours_charged; /*!< 电流充电时间 */
+
+    float watt_hours;         /*!< 功率时间 */
+    float watt_hours_charged; /*!< 功率充电时间 */
+
+    float motor_current; /*!< 电机电流 */
+    float total_current; /*!< 总电流 */
+
+    float mosfet_temperature; /*!< MOSFET 温度 */
+    float motor_temperature;  /*!< 电机温度 */
+
+    float pid_pos; /*!< 转子位置 */
+
+    int32_t tachometer_value;     /*!< 转速表 */
+    vesc_fault_code_t error_code; /*!< 错误码 */
+} vesc_motor_state_t;
+
 /**
  * @brief VESC 电机参数
+ * @note 反馈参数在 CAN 中断中更新, 任务中请使用 `vesc_motor_get_state` 读取
  */
 typedef struct {
     uint8_t vesc_id;         /*!< 电机 ID */
@@ -59,11 +87,15 @@ typedef struct {
 
     int32_t tachometer_value;     /*!< 转速表 */
     vesc_fault_code_t error_code; /*!< 错误码 */
+
+    seqlock_t state_lock; /*!< 反馈参数顺序锁 */
 } vesc_motor_handle_t;
 
 uint8_t vesc_motor_init(vesc_motor_handle_t *motor, uint8_t id,
                      can_selected_t can_select);
 uint8_t vesc_motor_deinit(vesc_motor_handle_t *motor);
+void vesc_motor_get_state(const vesc_motor_handle_t *motor,
+                          vesc_motor_state_t *state);
 
 void vesc_motor_set_duty(vesc_motor_handle_t *motor, float duty);
 void vesc_motor_set_current(vesc_motor_handle_t *motor, float current);
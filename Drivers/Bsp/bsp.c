@@ -18,14 +18,17 @@ void bsp_init(void) {
     delay_init(180);
     usart1_init(115200);
     usart2_init(115200);
+    crc_init();
     
     led_init();
     key_init();
 
     can1_init(1000, 350);
     can_list_add_can(can1_selected, 1, 4);
+    can_error_init(can1_selected);
 
     can2_init(1000, 350);
+    can_error_init(can2_selected);
 }
 
 #ifdef USE_FULL_ASSERT
@@ -25,6 +25,7 @@ extern "C" {
 #include "./DJI-Motor/dji_bldc_motor.h"
 #include "./VESC/vesc_motor.h"
 #include "./CAN/can_list.h"
+#include "./CAN/can_error.h"
 
 
 void bsp_init(void);
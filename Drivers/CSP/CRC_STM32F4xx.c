@@ -0,0 +1,327 @@
+/**
+ * @file    CRC_STM32F4xx.c
+ * @author  Deadline039
+ * @brief   Chip Support Package of CRC on STM32F4xx
+ * @version 1.0
+ * @date    2026-10-18
+ */
+
+#include <CSP_Config.h>
+
+#include "CRC_STM32F4xx.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#if CRC_ENABLE
+
+CRC_HandleTypeDef crc_handle = {.Instance = CRC};
+
+/* The CRC unit is used, set and clear with interrupt disabled. */
+static volatile uint8_t crc_busy = 0;
+
+#if CRC_DMA
+
+/* The maximum length of one DMA transfer, multiple of 4. */
+#define CRC_DMA_MAX_LENGTH 0xFFFCU
+
+/* DMA can not access the CCM RAM. */
+#define CRC_IS_CCMRAM(addr)                                                    \
+    (((uint32_t)(addr) & 0xFFFF0000U) == CCMDATARAM_BASE)
+
+static DMA_HandleTypeDef crc_dma_handle = {
+    .Instance = CSP_DMA_STREAM(CRC_DMA_NUMBER, CRC_DMA_STREAM),
+    .Init = {.Channel = CSP_DMA_CHANNEL(CRC_DMA_CHANNEL),
+             .Direction = DMA_MEMORY_TO_MEMORY,
+             .MemDataAlignment = DMA_MDATAALIGN_WORD,
+             .MemInc = DMA_MINC_DISABLE,
+             .Mode = DMA_NORMAL,
+             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
+             .PeriphInc = DMA_PINC_ENABLE,
+             .Priority = CSP_DMA_PRIORITY(CRC_DMA_PRIORITY),
+             .FIFOMode = DMA_FIFOMODE_ENABLE,
+             .FIFOThreshold = DMA_FIFO_THRESHOLD_FULL,
+             .MemBurst = DMA_MBURST_SINGLE,
+             .PeriphBurst = DMA_PBURST_SINGLE}};
+
+static const uint8_t *crc_dma_next; /* The next data to transfer. */
+static uint32_t crc_dma_remain;     /* The words remain, unit: byte. */
+static const uint8_t *crc_dma_tail; /* The trailing bytes. */
+static uint32_t crc_dma_tail_len;   /* The length of trailing bytes. */
+
+#endif /* CRC_DMA */
+
+/**
+ * @brief Try to take the CRC unit.
+ *
+ * @return `true` if the CRC unit is taken.
+ */
+static bool crc_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool locked = (crc_busy == 0);
+    crc_busy = 1;
+
+    __set_PRIMASK(primask);
+    return locked;
+}
+
+/**
+ * @brief Release the CRC unit.
+ *
+ */
+static inline void crc_unlock(void) {
+    crc_busy = 0;
+}
+
+/**
+ * @brief Process the trailing bytes by CPU.
+ *
+ * @param crc The CRC of the words.
+ * @param data The trailing bytes.
+ * @param len The length of trailing bytes, no more than 3.
+ * @return The CRC.
+ */
+static uint32_t crc_calc_tail(uint32_t crc, const uint8_t *data,
+                              uint32_t len) {
+    while (len--) {
+        crc ^= (uint32_t)(*data++) << 24;
+
+        for (uint8_t i = 0; i < 8; ++i) {
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ 0x04C11DB7U)
+                                      : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief CRC initialization.
+ *
+ * @return CRC init status:
+ * @retval - 0: `CRC_INIT_OK`:     Success.
+ * @retval - 1: `CRC_INIT_FAIL`:   CRC or DMA init failed.
+ * @retval - 2: `CRC_INITED`:      CRC is inited.
+ */
+uint8_t crc_init(void) {
+    if (HAL_CRC_GetState(&crc_handle) != HAL_CRC_STATE_RESET) {
+        return CRC_INITED;
+    }
+
+#if CRC_DMA
+    CSP_DMA_CLK_ENABLE(CRC_DMA_NUMBER);
+    if (HAL_DMA_Init(&crc_dma_handle) != HAL_OK) {
+        return CRC_INIT_FAIL;
+    }
+#endif /* CRC_DMA */
+
+    if (HAL_CRC_Init(&crc_handle) != HAL_OK) {
+        return CRC_INIT_FAIL;
+    }
+
+    return CRC_INIT_OK;
+}
+
+/**
+ * @brief CRC deinitialization.
+ *
+ * @return CRC deinit status:
+ * @retval - 0: `CRC_DEINIT_OK`:   Success.
+ * @retval - 1: `CRC_DEINIT_FAIL`: CRC deinit failed.
+ * @retval - 2: `CRC_NO_INIT`:     CRC is not init.
+ */
+uint8_t crc_deinit(void) {
+    if (HAL_CRC_GetState(&crc_handle) == HAL_CRC_STATE_RESET) {
+        return CRC_NO_INIT;
+    }
+
+#if CRC_DMA
+    HAL_DMA_Abort(&crc_dma_handle);
+    HAL_DMA_DeInit(&crc_dma_handle);
+#endif /* CRC_DMA */
+
+    if (HAL_CRC_DeInit(&crc_handle) != HAL_OK) {
+        return CRC_DEINIT_FAIL;
+    }
+
+    crc_unlock();
+    return CRC_DEINIT_OK;
+}
+
+/**
+ * @brief CRC low level initialization.
+ *
+ * @param hcrc The handle of CRC.
+ */
+void HAL_CRC_MspInit(CRC_HandleTypeDef *hcrc) {
+    UNUSED(hcrc);
+    __HAL_RCC_CRC_CLK_ENABLE();
+}
+
+/**
+ * @brief CRC low level deinitialization.
+ *
+ * @param hcrc The handle of CRC.
+ */
+void HAL_CRC_MspDeInit(CRC_HandleTypeDef *hcrc) {
+    UNUSED(hcrc);
+    __HAL_RCC_CRC_CLK_DISABLE();
+}
+
+/**
+ * @brief Calculate the CRC of data.
+ *
+ * @param data The data.
+ * @param len The length of data.
+ * @param[out] crc The CRC.
+ * @return Calculate status:
+ * @retval - 0: `CRC_OK`:     Success.
+ * @retval - 1: `CRC_BUSY`:   The CRC unit is used by others.
+ * @retval - 2: `CRC_ERROR`:  Parameter error, CRC is not init or DMA error.
+ * @note Waits for the DMA if the data is not shorter than
+ *       `CRC_DMA_THRESHOLD`, use `crc_calc_dma_start` to do other things
+ *       while the DMA is working.
+ */
+uint8_t crc_calc(const void *data, size_t len, uint32_t *crc) {
+    if ((data == NULL && len != 0) || crc == NULL) {
+        return CRC_ERROR;
+    }
+
+    if (HAL_CRC_GetState(&crc_handle) == HAL_CRC_STATE_RESET) {
+        return CRC_ERROR;
+    }
+
+#if CRC_DMA
+    if (len >= CRC_DMA_THRESHOLD && len >= 4 && !CRC_IS_CCMRAM(data)) {
+        uint8_t res = crc_calc_dma_start(data, len);
+        if (res != CRC_OK) {
+            return res;
+        }
+
+        while ((res = crc_calc_dma_result(crc)) == CRC_BUSY) {
+        }
+
+        return res;
+    }
+#endif /* CRC_DMA */
+
+    if (!crc_lock()) {
+        return CRC_BUSY;
+    }
+
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t word;
+
+    __HAL_CRC_DR_RESET(&crc_handle);
+
+    for (size_t i = len >> 2; i > 0; --i) {
+        memcpy(&word, p, sizeof(word));
+        crc_handle.Instance->DR = word;
+        p += 4;
+    }
+
+    *crc = crc_calc_tail(crc_handle.Instance->DR, p, len & 3U);
+
+    crc_unlock();
+    return CRC_OK;
+}
+
+#if CRC_DMA
+
+/**
+ * @brief Start the next DMA transfer.
+ *
+ */
+static void crc_dma_next_transfer(void) {
+    uint32_t len = (crc_dma_remain > CRC_DMA_MAX_LENGTH) ? CRC_DMA_MAX_LENGTH
+                                                         : crc_dma_remain;
+
+    HAL_DMA_Start(&crc_dma_handle, (uint32_t)crc_dma_next,
+                  (uint32_t)&crc_handle.Instance->DR, len);
+
+    crc_dma_next += len;
+    crc_dma_remain -= len;
+}
+
+/**
+ * @brief Start to calculate the CRC by DMA.
+ *
+ * @param data The data, can not be in the CCM RAM. Keep it unchanged until
+ *             the calculation finished.
+ * @param len The length of data, at least 4 bytes.
+ * @return Start status:
+ * @retval - 0: `CRC_OK`:     Success, call `crc_calc_dma_result` to get the
+ *                            result.
+ * @retval - 1: `CRC_BUSY`:   The CRC unit is used by others.
+ * @retval - 2: `CRC_ERROR`:  Parameter error or CRC is not init.
+ */
+uint8_t crc_calc_dma_start(const void *data, size_t len) {
+    if (data == NULL || len < 4 || CRC_IS_CCMRAM(data)) {
+        return CRC_ERROR;
+    }
+
+    if (HAL_CRC_GetState(&crc_handle) == HAL_CRC_STATE_RESET) {
+        return CRC_ERROR;
+    }
+
+    if (!crc_lock()) {
+        return CRC_BUSY;
+    }
+
+    crc_dma_next = (const uint8_t *)data;
+    crc_dma_remain = len & ~3U;
+    crc_dma_tail = crc_dma_next + crc_dma_remain;
+    crc_dma_tail_len = len & 3U;
+
+    __HAL_CRC_DR_RESET(&crc_handle);
+    crc_dma_next_transfer();
+
+    return CRC_OK;
+}
+
+/**
+ * @brief Get the result of `crc_calc_dma_start`.
+ *
+ * @param[out] crc The CRC.
+ * @return Calculate status:
+ * @retval - 0: `CRC_OK`:     Success, the CRC unit is released.
+ * @retval - 1: `CRC_BUSY`:   The DMA is working, call again later.
+ * @retval - 2: `CRC_ERROR`:  No DMA calculation is started, or DMA error.
+ * @note Only the caller of `crc_calc_dma_start` can call this function.
+ */
+uint8_t crc_calc_dma_result(uint32_t *crc) {
+    if (crc == NULL || crc_dma_handle.State != HAL_DMA_STATE_BUSY) {
+        return CRC_ERROR;
+    }
+
+    if (!__HAL_DMA_GET_FLAG(&crc_dma_handle,
+                            __HAL_DMA_GET_TC_FLAG_INDEX(&crc_dma_handle)) &&
+        !__HAL_DMA_GET_FLAG(&crc_dma_handle,
+                            __HAL_DMA_GET_TE_FLAG_INDEX(&crc_dma_handle))) {
+        return CRC_BUSY;
+    }
+
+    /* Transfer is finished, clear the flags and the state. */
+    if (HAL_DMA_PollForTransfer(&crc_dma_handle, HAL_DMA_FULL_TRANSFER,
+                                HAL_MAX_DELAY) != HAL_OK) {
+        crc_unlock();
+        return CRC_ERROR;
+    }
+
+    if (crc_dma_remain != 0) {
+        crc_dma_next_transfer();
+        return CRC_BUSY;
+    }
+
+    *crc = crc_calc_tail(crc_handle.Instance->DR, crc_dma_tail,
+                         crc_dma_tail_len);
+
+    crc_unlock();
+    return CRC_OK;
+}
+
+#endif /* CRC_DMA */
+
+#endif /* CRC_ENABLE */
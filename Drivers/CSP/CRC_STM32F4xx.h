@@ -0,0 +1,62 @@
+/**
+ * @file    CRC_STM32F4xx.h
+ * @author  Deadline039
+ * @brief   Chip Support Package of CRC on STM32F4xx
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    The CRC unit calculates CRC-32/MPEG-2 (polynomial 0x04C11DB7,
+ *          initial value 0xFFFFFFFF, no reflection, no final XOR) of 32-bit
+ *          words, MSB first. The data is read as little-endian words, so the
+ *          bytes of each word are processed in the order 3, 2, 1, 0. The
+ *          trailing 1~3 bytes are processed in order by CPU.
+ *          `crc32_calc` in `User/Utils/crc.h` gives the same result without
+ *          the hardware.
+ *
+ *          Data not shorter than `CRC_DMA_THRESHOLD` is written to the CRC
+ *          unit by DMA (memory to memory). The source needs no alignment, the
+ *          DMA FIFO packs the bytes into words.
+ *
+ *          The CRC unit is used by one caller at a time, other callers get
+ *          `CRC_BUSY` and should calculate by software.
+ */
+
+#ifndef __CRC_STM32F4XX_H
+#define __CRC_STM32F4XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#if CRC_ENABLE
+
+extern CRC_HandleTypeDef crc_handle;
+
+#define CRC_INIT_OK     0
+#define CRC_INIT_FAIL   1
+#define CRC_INITED      2
+
+#define CRC_DEINIT_OK   0
+#define CRC_DEINIT_FAIL 1
+#define CRC_NO_INIT     2
+
+#define CRC_OK          0
+#define CRC_BUSY        1
+#define CRC_ERROR       2
+
+uint8_t crc_init(void);
+uint8_t crc_deinit(void);
+
+uint8_t crc_calc(const void *data, size_t len, uint32_t *crc);
+
+#if CRC_DMA
+uint8_t crc_calc_dma_start(const void *data, size_t len);
+uint8_t crc_calc_dma_result(uint32_t *crc);
+#endif /* CRC_DMA */
+
+#endif /* CRC_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_STM32F4XX_H */
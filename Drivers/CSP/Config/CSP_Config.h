@@ -152,7 +152,7 @@
 #endif  /* USART1_RX_DMA */
 
 //   <e> Enable USART1 DMA TX
-#define USART1_TX_DMA             0
+#define USART1_TX_DMA             1
 
 #if USART1_TX_DMA
 
@@ -184,9 +184,10 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define USART1_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
-#define USART1_TX_DMA_BUF_SIZE    256
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
+#define USART1_TX_DMA_BUF_SIZE    320
 
 //   </e>
 
@@ -280,7 +281,7 @@
 
 //   <o> USART2 Interrupt Priority <0-15>
 //   <i> The Interrupt Priority of USART2
-#define USART2_IT_PRIORITY        2
+#define USART2_IT_PRIORITY        5
 //   <o> USART2 Interrupt SubPriority <0-15>
 //   <i> The Interrupt SubPriority of USART2
 #define USART2_IT_SUB             3
@@ -315,7 +316,7 @@
 
 //     <o> DMA RX Interrupt Priority <0-15>
 //     <i>  The Interrupt Priority of DMA Rx
-#define USART2_RX_DMA_IT_PRIORITY 2
+#define USART2_RX_DMA_IT_PRIORITY 5
 
 //     <o> DMA RX Interrupt SubPriority <0-15>
 //     <i>  The Interrupt SubPriority of DMA Rx
@@ -366,9 +367,10 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define USART2_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
-#define USART2_TX_DMA_BUF_SIZE    256
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
+#define USART2_TX_DMA_BUF_SIZE    320
 
 //   </e>
 
@@ -560,8 +562,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define USART3_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define USART3_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -754,8 +757,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART4_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART4_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -952,8 +956,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART5_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART5_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -1142,8 +1147,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define USART6_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define USART6_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -1288,8 +1294,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART7_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART7_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -1426,8 +1433,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART8_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART8_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -1572,8 +1580,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART9_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART9_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -1718,8 +1727,9 @@
 //     <i>  The Interrupt SubPriority of DMA Rx
 #define UART10_TX_DMA_IT_SUB      2
 
-//     <o> The size of Receive buf [byte]
-//     <i>  Write data to Send buf, and sending with thread safety
+//     <o> The size of Send buf [byte]
+//     <i>  Two buffers of this size are allocated, one is filled while the
+//     <i>  other is being sent. It must hold the longest frame
 #define UART10_TX_DMA_BUF_SIZE    256
 
 //   </e>
@@ -3910,7 +3920,7 @@
 #endif /* CAN1_TX_IT_ENABLE */
 
 //   <e> Enable CAN1 SCE Interrupt
-#define CAN1_SCE_IT_ENABLE 0
+#define CAN1_SCE_IT_ENABLE 1
 
 #if CAN1_SCE_IT_ENABLE
 
@@ -4012,7 +4022,7 @@
 #endif /* CAN2_TX_IT_ENABLE */
 
 //   <e> Enable CAN2 SCE Interrupt
-#define CAN2_SCE_IT_ENABLE 0
+#define CAN2_SCE_IT_ENABLE 1
 
 #if CAN2_SCE_IT_ENABLE
 
@@ -4435,6 +4445,45 @@
 
 // </e>
 
+// <e> CRC (Cyclic Redundancy Check calculation unit)
+#define CRC_ENABLE            1
+
+#if CRC_ENABLE
+
+//   <e> Enable CRC DMA (Memory to memory, DMA2 only)
+#define CRC_DMA               1
+
+#if CRC_DMA
+
+//     <o> Number
+//      <2=>2 
+//     <i>  Selects DMA Number
+#define CRC_DMA_NUMBER        2
+
+//     <o> Stream <0-7>
+//     <i>  Selects DMA Stream
+#define CRC_DMA_STREAM        0
+
+//     <o> Channel <0-7>
+//     <i>  Selects DMA Channel
+#define CRC_DMA_CHANNEL       0
+
+//     <o> Priority
+//      <0=>Low <1=>Medium <2=>High <3=>Very High
+//     <i>  Selects DMA Priority
+#define CRC_DMA_PRIORITY      0
+
+//     <o> DMA Threshold [byte]
+//     <i>  Data shorter than this is written to the CRC unit by CPU
+#define CRC_DMA_THRESHOLD     64
+
+#endif /* CRC_DMA */
+//   </e>
+
+#endif /* CRC_ENABLE */
+
+// </e>
+
 //------------- <<< end of configuration section >>> -----------------------
 
 #ifdef __cplusplus
@@ -4510,6 +4559,10 @@ extern "C" {
 #include "../RTC_STM32F4xx.h"
 #endif /* RTC_ENABLE */
 
+#if (CRC_ENABLE)
+#include "../CRC_STM32F4xx.h"
+#endif /* CRC_ENABLE */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -2,9 +2,10 @@
  * @file    UART_STM32F4xx.c
  * @author  Deadline039
  * @brief   Chip Support Package of UART on STM32F4xx
- * @version 1.0
- * @date    2025-02-27
- * @note    Generate Automatically. 
+ * @version 1.1
+ * @date    2026-10-18
+ * @note    The instances are defined by `UART_STM32F4xx_port.h`, and share
+ *          the implementation of `uart_port_xxx`.
  */
 
 #include <CSP_Config.h>
@@ -12,6 +13,7 @@
 #include "UART_STM32F4xx.h"
 
 #include "./ring_fifo/ring_fifo.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -25,16 +27,28 @@ static char uart_buffer[256];
 
 /**
  * @brief Send buf of UART.
+ * @note Two buffers of `buf_size` in a row (ping-pong). Writers queue frames
+ *       in the back buffer while DMA is transmitting the front buffer, the
+ *       Tx complete callback swaps them and starts the next transfer.
+ *       The fields are modified with interrupt disabled.
  */
 typedef struct {
-    uint8_t *send_buf; /*!< Send data buf.                                  */
-    uint32_t head_ptr; /*!< Pointer of send buf to control the length of DMA
-                            transfer.                                       */
-    size_t buf_size;   /*!< The size of buffer. Prevent overflow.           */
+    uint8_t *send_buf; /*!< Send data buf, two buffers.                     */
+    uint32_t head_ptr; /*!< Pointer of the back buffer, the length of the
+                            queued frames.                                  */
+    size_t buf_size;   /*!< The size of one buffer. Prevent overflow.       */
+    uint8_t back;      /*!< Index of the back buffer, 0 or 1.               */
+    uint8_t writers;   /*!< Frames reserved but not committed.              */
+    uint8_t busy;      /*!< DMA is transmitting the front buffer.           */
+    uint8_t pending;   /*!< Send is requested but the DMA is busy or a frame
+                            is being written.                               */
 } uart_tx_buf_t;
 
 /**
  * @brief Receive fifo of UART.
+ * @note `head_ptr` and `read_ptr` count the received bytes from init and
+ *       wrap at 2^32, the position in `recv_buf` is the count modulo
+ *       `buf_size`.
  */
 typedef struct {
     ring_fifo_t *rx_fifo; /*!< Receive fifo.                 */
@@ -42,10 +56,50 @@ typedef struct {
     uint8_t *recv_buf;    /*!< Data buf of DMA to transfer.  */
     uint32_t head_ptr;    /*!< Pointer of receive buf to
                                control the DMA receive.      */
+    uint32_t read_ptr;    /*!< Pointer of zero-copy reader.  */
     uint32_t buf_size;    /*!< Size of `recv_buf`.           */
     uint32_t fifo_size;   /*!< Size of `rx_fifo_buf`.        */
+    uint8_t zero_copy;    /*!< Read by `uart_dmarx_peek`, the
+                               fifo is not used.             */
 } uart_rx_fifo_t;
 
+/**
+ * @brief Pin of UART.
+ */
+typedef struct {
+    GPIO_TypeDef *port; /*!< GPIO port, `NULL` if the pin is not used. */
+    uint32_t pin;       /*!< GPIO pin.                                  */
+    uint8_t af;         /*!< Alternate function.                        */
+} uart_pin_t;
+
+/**
+ * @brief Interrupt of UART or DMA.
+ */
+typedef struct {
+    IRQn_Type irqn;   /*!< Interrupt number.                */
+    uint8_t priority; /*!< Preempt priority.                */
+    uint8_t sub;      /*!< Sub priority.                    */
+    bool enable;      /*!< `false` if the interrupt is not used. */
+} uart_irq_t;
+
+/**
+ * @brief Driver of one UART instance, defined by `UART_STM32F4xx_port.h`.
+ */
+typedef struct {
+    UART_HandleTypeDef *huart;  /*!< The handle of UART.                   */
+    void (*clk_enable)(void);   /*!< Enable the clock of UART, GPIO, DMA.  */
+    void (*clk_disable)(void);  /*!< Disable the clock of UART.            */
+    uart_pin_t tx, rx;          /*!< Tx and Rx pins.                       */
+    uart_pin_t cts, rts;        /*!< Hardware flow control pins.           */
+    uart_irq_t irq;             /*!< UART interrupt.                       */
+    DMA_HandleTypeDef *dmarx;   /*!< Rx DMA, `NULL` if not used.           */
+    uart_irq_t dmarx_irq;       /*!< Rx DMA interrupt.                     */
+    uart_rx_fifo_t *rx_fifo;    /*!< Receive fifo of Rx DMA.               */
+    DMA_HandleTypeDef *dmatx;   /*!< Tx DMA, `NULL` if not used.           */
+    uart_irq_t dmatx_irq;       /*!< Tx DMA interrupt.                     */
+    uart_tx_buf_t *tx_buf;      /*!< Send buf of Tx DMA.                   */
+} uart_port_t;
+
 /**
  * @}
  */
@@ -58,2730 +112,185 @@ typedef struct {
 static void uart_dmarx_halfdone_callback(UART_HandleTypeDef *huart);
 static void uart_dmarx_done_callback(UART_HandleTypeDef *huart);
 void uart_dmarx_idle_callback(UART_HandleTypeDef *huart);
+static void uart_dmatx_done_callback(UART_HandleTypeDef *huart);
+static void uart_dmatx_reset(uart_tx_buf_t *tx_buf);
+
+static uint8_t uart_port_init(const uart_port_t *port, uint32_t baud_rate);
+static uint8_t uart_port_deinit(const uart_port_t *port);
+static void uart_port_irq_handler(const uart_port_t *port);
 
 /**
  * @}
  */
 
 /*****************************************************************************
- * @defgroup USART1 Functions
+ * @defgroup UART instances.
  * @{
  */
 
 #if USART1_ENABLE
+#define UART_PORT_INSTANCE USART1
+#define UART_PORT_PREFIX   USART1_
+#define UART_PORT_name     usart1
+#include "UART_STM32F4xx_port.h"
+#endif /* USART1_ENABLE */
 
-UART_HandleTypeDef usart1_handle = {.Instance = USART1,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if USART1_RX_DMA
-
-static DMA_HandleTypeDef usart1_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(USART1_RX_DMA_NUMBER, USART1_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART1_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART1_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t usart1_rx_fifo = {.buf_size = USART1_RX_DMA_BUF_SIZE,
-                                        .fifo_size = USART1_RX_DMA_FIFO_SIZE};
-
-#endif /* USART1_RX_DMA */
-
-#if USART1_TX_DMA
-
-static DMA_HandleTypeDef usart1_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(USART1_TX_DMA_NUMBER, USART1_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART1_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART1_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t usart1_tx_buf = {.buf_size = USART1_TX_DMA_BUF_SIZE};
-
-#endif /* USART1_TX_DMA */
-
-/**
- * @brief USART1 initialization
- *
- * @param baud_rate Baud rate.
- * @return USART1 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t usart1_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&usart1_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    usart1_handle.Init.BaudRate = baud_rate;
-#if USART1_TX
-    usart1_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(USART1_TX_PORT);
-    gpio_init_struct.Pin = USART1_TX_PIN;
-    gpio_init_struct.Alternate = USART1_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART1_TX_PORT), &gpio_init_struct);
-#endif /* USART1_TX */
-
-#if USART1_RX
-    usart1_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(USART1_RX_PORT);
-    gpio_init_struct.Pin = USART1_RX_PIN;
-    gpio_init_struct.Alternate = USART1_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART1_RX_PORT), &gpio_init_struct);
-#endif /* USART1_RX */
-
-#if USART1_CTS
-    usart1_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
-
-    CSP_GPIO_CLK_ENABLE(USART1_CTS_PORT);
-    gpio_init_struct.Pin = USART1_CTS_PIN;
-    gpio_init_struct.Alternate = USART1_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART1_CTS_PORT), &gpio_init_struct);
-#endif /* USART1_USART1_CTS */
-
-#if USART1_RTS
-    usart1_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(USART1_RTS_PORT);
-    gpio_init_struct.Pin = USART1_RTS_PIN;
-    gpio_init_struct.Alternate = USART1_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART1_RTS_PORT), &gpio_init_struct);
-#endif /* USART1_RTS */
-
-    __HAL_RCC_USART1_CLK_ENABLE();
-#if USART1_IT_ENABLE
-    HAL_NVIC_EnableIRQ(USART1_IRQn);
-    HAL_NVIC_SetPriority(USART1_IRQn, USART1_IT_PRIORITY, USART1_IT_SUB);
-#endif /* USART1_IT_ENABLE */
-
-#if USART1_RX_DMA
-    usart1_rx_fifo.head_ptr = 0;
-
-    usart1_rx_fifo.recv_buf = CSP_MALLOC(usart1_rx_fifo.buf_size);
-    if (usart1_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart1_rx_fifo.rx_fifo_buf = CSP_MALLOC(usart1_rx_fifo.fifo_size);
-    if (usart1_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart1_rx_fifo.rx_fifo = ring_fifo_init(
-        usart1_rx_fifo.rx_fifo_buf, usart1_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (usart1_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART1_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart1_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart1_handle, hdmarx, usart1_dmarx_handle);
-
-    HAL_NVIC_SetPriority(USART1_RX_DMA_IRQn, USART1_RX_DMA_IT_PRIORITY, USART1_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART1_RX_DMA_IRQn);
-
-#endif /* USART1_RX_DMA */
-
-#if USART1_TX_DMA
-    usart1_tx_buf.send_buf = CSP_MALLOC(usart1_tx_buf.buf_size);
-    if (usart1_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART1_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart1_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart1_handle, hdmatx, usart1_dmatx_handle);
-
-    HAL_NVIC_SetPriority(USART1_TX_DMA_IRQn, USART1_TX_DMA_IT_PRIORITY, USART1_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART1_TX_DMA_IRQn);
-
-#endif /* USART1_TX_DMA */
-
-    if (HAL_UART_Init(&usart1_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if USART1_RX_DMA
-    __HAL_UART_ENABLE_IT(&usart1_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&usart1_handle);
-
-    HAL_UART_Receive_DMA(&usart1_handle, usart1_rx_fifo.recv_buf,
-                         usart1_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&usart1_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&usart1_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* USART1_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if USART1_IT_ENABLE
-
-/**
- * @brief USART1 ISR
- *
- */
-void USART1_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&usart1_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&usart1_handle);
-        uart_dmarx_idle_callback(&usart1_handle);
-    }
+#if USART2_ENABLE
+#define UART_PORT_INSTANCE USART2
+#define UART_PORT_PREFIX   USART2_
+#define UART_PORT_name     usart2
+#include "UART_STM32F4xx_port.h"
+#endif /* USART2_ENABLE */
 
-    HAL_UART_IRQHandler(&usart1_handle);
-}
+#if USART3_ENABLE
+#define UART_PORT_INSTANCE USART3
+#define UART_PORT_PREFIX   USART3_
+#define UART_PORT_name     usart3
+#include "UART_STM32F4xx_port.h"
+#endif /* USART3_ENABLE */
 
-#endif /* USART1_IT_ENABLE */
+#if UART4_ENABLE
+#define UART_PORT_INSTANCE UART4
+#define UART_PORT_PREFIX   UART4_
+#define UART_PORT_name     uart4
+#include "UART_STM32F4xx_port.h"
+#endif /* UART4_ENABLE */
 
-#if USART1_RX_DMA
+#if UART5_ENABLE
+#define UART_PORT_INSTANCE UART5
+#define UART_PORT_PREFIX   UART5_
+#define UART_PORT_name     uart5
+#include "UART_STM32F4xx_port.h"
+#endif /* UART5_ENABLE */
 
-/**
- * @brief USART1 Rx DMA ISR
- *
- */
-void USART1_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart1_dmarx_handle);
-}
+#if USART6_ENABLE
+#define UART_PORT_INSTANCE USART6
+#define UART_PORT_PREFIX   USART6_
+#define UART_PORT_name     usart6
+#include "UART_STM32F4xx_port.h"
+#endif /* USART6_ENABLE */
 
-#endif /* USART1_RX_DMA */
+#if UART7_ENABLE
+#define UART_PORT_INSTANCE UART7
+#define UART_PORT_PREFIX   UART7_
+#define UART_PORT_name     uart7
+#include "UART_STM32F4xx_port.h"
+#endif /* UART7_ENABLE */
 
-#if USART1_TX_DMA
+#if UART8_ENABLE
+#define UART_PORT_INSTANCE UART8
+#define UART_PORT_PREFIX   UART8_
+#define UART_PORT_name     uart8
+#include "UART_STM32F4xx_port.h"
+#endif /* UART8_ENABLE */
 
-/**
- * @brief USART1 Rx DMA ISR
- *
- */
-void USART1_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart1_dmatx_handle);
-}
+#if UART9_ENABLE
+#define UART_PORT_INSTANCE UART9
+#define UART_PORT_PREFIX   UART9_
+#define UART_PORT_name     uart9
+#include "UART_STM32F4xx_port.h"
+#endif /* UART9_ENABLE */
 
-#endif /* USART1_TX_DMA */
+#if UART10_ENABLE
+#define UART_PORT_INSTANCE UART10
+#define UART_PORT_PREFIX   UART10_
+#define UART_PORT_name     uart10
+#include "UART_STM32F4xx_port.h"
+#endif /* UART10_ENABLE */
 
 /**
- * @brief USART1 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
+ * The UART instances are 1 KB apart, bit 10 to 14 of the base address are
+ * unique among them (USART2: 17, USART3: 18, UART4: 19, UART5: 20,
+ * UART7: 30, UART8: 31, USART1: 4, USART6: 5, UART9: 6, UART10: 7), so the
+ * driver is found with one shift and one load.
  */
-uint8_t usart1_deinit(void) {
-    if (HAL_UART_GetState(&usart1_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_USART1_CLK_DISABLE();
-
-#if USART1_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART1_TX_PORT), USART1_TX_PIN);
-#endif /* USART1_TX */
-
-#if USART1_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART1_RX_PORT), USART1_RX_PIN);
-#endif /* USART1_RX */
-
-#if USART1_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART1_CTS_PORT), USART1_CTS_PIN);
-#endif /* USART1_USART1_CTS */
-
-#if USART1_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART1_RTS_PORT), USART1_RTS_PIN);
-#endif /* USART1_RTS */
-
-#if USART1_IT_ENABLE
-    HAL_NVIC_DisableIRQ(USART1_IRQn);
-#endif /* USART1_IT_ENABLE */
-
-#if USART1_RX_DMA
-
-    HAL_DMA_Abort(&usart1_dmarx_handle);
-    CSP_FREE(usart1_rx_fifo.recv_buf);
-    CSP_FREE(usart1_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(usart1_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&usart1_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART1_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&usart1_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&usart1_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    usart1_handle.hdmarx = NULL;
-
-#endif /* USART1_RX_DMA */
-
-#if USART1_TX_DMA
-    HAL_DMA_Abort(&usart1_dmatx_handle);
-    CSP_FREE(usart1_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&usart1_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART1_TX_DMA_IRQn);
-
-    usart1_handle.hdmatx = NULL;
-#endif /* USART1_TX_DMA */
-
-    if (HAL_UART_DeInit(&usart1_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
+#define UART_PORT_INDEX(instance) ((((uintptr_t)(instance)) >> 10) & 0x1FU)
 
+/* The drivers of enabled UART, bound at compile time. */
+static const uart_port_t *const uart_port_table[32] = {
+#if USART1_ENABLE
+    [UART_PORT_INDEX(USART1_BASE)] = &usart1_port,
 #endif /* USART1_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup USART2 Functions
- * @{
- */
-
 #if USART2_ENABLE
-
-UART_HandleTypeDef usart2_handle = {.Instance = USART2,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if USART2_RX_DMA
-
-static DMA_HandleTypeDef usart2_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(USART2_RX_DMA_NUMBER, USART2_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART2_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART2_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t usart2_rx_fifo = {.buf_size = USART2_RX_DMA_BUF_SIZE,
-                                        .fifo_size = USART2_RX_DMA_FIFO_SIZE};
-
-#endif /* USART2_RX_DMA */
-
-#if USART2_TX_DMA
-
-static DMA_HandleTypeDef usart2_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(USART2_TX_DMA_NUMBER, USART2_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART2_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART2_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t usart2_tx_buf = {.buf_size = USART2_TX_DMA_BUF_SIZE};
-
-#endif /* USART2_TX_DMA */
+    [UART_PORT_INDEX(USART2_BASE)] = &usart2_port,
+#endif /* USART2_ENABLE */
+#if USART3_ENABLE
+    [UART_PORT_INDEX(USART3_BASE)] = &usart3_port,
+#endif /* USART3_ENABLE */
+#if UART4_ENABLE
+    [UART_PORT_INDEX(UART4_BASE)] = &uart4_port,
+#endif /* UART4_ENABLE */
+#if UART5_ENABLE
+    [UART_PORT_INDEX(UART5_BASE)] = &uart5_port,
+#endif /* UART5_ENABLE */
+#if USART6_ENABLE
+    [UART_PORT_INDEX(USART6_BASE)] = &usart6_port,
+#endif /* USART6_ENABLE */
+#if UART7_ENABLE
+    [UART_PORT_INDEX(UART7_BASE)] = &uart7_port,
+#endif /* UART7_ENABLE */
+#if UART8_ENABLE
+    [UART_PORT_INDEX(UART8_BASE)] = &uart8_port,
+#endif /* UART8_ENABLE */
+#if UART9_ENABLE
+    [UART_PORT_INDEX(UART9_BASE)] = &uart9_port,
+#endif /* UART9_ENABLE */
+#if UART10_ENABLE
+    [UART_PORT_INDEX(UART10_BASE)] = &uart10_port,
+#endif /* UART10_ENABLE */
+};
 
 /**
- * @brief USART2 initialization
+ * @brief Find the driver of UART.
  *
- * @param baud_rate Baud rate.
- * @return USART2 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
+ * @param huart The handle of UART.
+ * @return The driver, `NULL` if the handle is not defined by this file.
  */
-uint8_t usart2_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&usart2_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    usart2_handle.Init.BaudRate = baud_rate;
-#if USART2_TX
-    usart2_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(USART2_TX_PORT);
-    gpio_init_struct.Pin = USART2_TX_PIN;
-    gpio_init_struct.Alternate = USART2_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART2_TX_PORT), &gpio_init_struct);
-#endif /* USART2_TX */
-
-#if USART2_RX
-    usart2_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(USART2_RX_PORT);
-    gpio_init_struct.Pin = USART2_RX_PIN;
-    gpio_init_struct.Alternate = USART2_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART2_RX_PORT), &gpio_init_struct);
-#endif /* USART2_RX */
-
-#if USART2_CTS
-    usart2_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
+static inline const uart_port_t *uart_port_identify(UART_HandleTypeDef *huart) {
+    const uart_port_t *port = uart_port_table[UART_PORT_INDEX(huart->Instance)];
 
-    CSP_GPIO_CLK_ENABLE(USART2_CTS_PORT);
-    gpio_init_struct.Pin = USART2_CTS_PIN;
-    gpio_init_struct.Alternate = USART2_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART2_CTS_PORT), &gpio_init_struct);
-#endif /* USART2_USART2_CTS */
-
-#if USART2_RTS
-    usart2_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(USART2_RTS_PORT);
-    gpio_init_struct.Pin = USART2_RTS_PIN;
-    gpio_init_struct.Alternate = USART2_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART2_RTS_PORT), &gpio_init_struct);
-#endif /* USART2_RTS */
-
-    __HAL_RCC_USART2_CLK_ENABLE();
-#if USART2_IT_ENABLE
-    HAL_NVIC_EnableIRQ(USART2_IRQn);
-    HAL_NVIC_SetPriority(USART2_IRQn, USART2_IT_PRIORITY, USART2_IT_SUB);
-#endif /* USART2_IT_ENABLE */
-
-#if USART2_RX_DMA
-    usart2_rx_fifo.head_ptr = 0;
-
-    usart2_rx_fifo.recv_buf = CSP_MALLOC(usart2_rx_fifo.buf_size);
-    if (usart2_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart2_rx_fifo.rx_fifo_buf = CSP_MALLOC(usart2_rx_fifo.fifo_size);
-    if (usart2_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart2_rx_fifo.rx_fifo = ring_fifo_init(
-        usart2_rx_fifo.rx_fifo_buf, usart2_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (usart2_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART2_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart2_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart2_handle, hdmarx, usart2_dmarx_handle);
-
-    HAL_NVIC_SetPriority(USART2_RX_DMA_IRQn, USART2_RX_DMA_IT_PRIORITY, USART2_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART2_RX_DMA_IRQn);
-
-#endif /* USART2_RX_DMA */
-
-#if USART2_TX_DMA
-    usart2_tx_buf.send_buf = CSP_MALLOC(usart2_tx_buf.buf_size);
-    if (usart2_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
+    if ((port == NULL) || (port->huart != huart)) {
+        return NULL;
     }
 
-    CSP_DMA_CLK_ENABLE(USART2_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart2_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart2_handle, hdmatx, usart2_dmatx_handle);
-
-    HAL_NVIC_SetPriority(USART2_TX_DMA_IRQn, USART2_TX_DMA_IT_PRIORITY, USART2_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART2_TX_DMA_IRQn);
-
-#endif /* USART2_TX_DMA */
-
-    if (HAL_UART_Init(&usart2_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if USART2_RX_DMA
-    __HAL_UART_ENABLE_IT(&usart2_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&usart2_handle);
-
-    HAL_UART_Receive_DMA(&usart2_handle, usart2_rx_fifo.recv_buf,
-                         usart2_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&usart2_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&usart2_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* USART2_RX_DMA */
-    return UART_INIT_OK;
+    return port;
 }
 
-#if USART2_IT_ENABLE
-
 /**
- * @brief USART2 ISR
+ * @brief Init a pin of UART.
  *
+ * @param pin The pin.
  */
-void USART2_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&usart2_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&usart2_handle);
-        uart_dmarx_idle_callback(&usart2_handle);
+static void uart_port_pin_init(const uart_pin_t *pin) {
+    if (pin->port == NULL) {
+        return;
     }
 
-    HAL_UART_IRQHandler(&usart2_handle);
-}
-
-#endif /* USART2_IT_ENABLE */
-
-#if USART2_RX_DMA
-
-/**
- * @brief USART2 Rx DMA ISR
- *
- */
-void USART2_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart2_dmarx_handle);
-}
-
-#endif /* USART2_RX_DMA */
-
-#if USART2_TX_DMA
-
-/**
- * @brief USART2 Rx DMA ISR
- *
- */
-void USART2_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart2_dmatx_handle);
+    GPIO_InitTypeDef gpio_init_struct = {.Pin = pin->pin,
+                                         .Pull = GPIO_PULLUP,
+                                         .Speed = GPIO_SPEED_FREQ_HIGH,
+                                         .Mode = GPIO_MODE_AF_PP,
+                                         .Alternate = pin->af};
+    HAL_GPIO_Init(pin->port, &gpio_init_struct);
 }
 
-#endif /* USART2_TX_DMA */
-
 /**
- * @brief USART2 deinitialization.
+ * @brief Deinit a pin of UART.
  *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
+ * @param pin The pin.
  */
-uint8_t usart2_deinit(void) {
-    if (HAL_UART_GetState(&usart2_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_USART2_CLK_DISABLE();
-
-#if USART2_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART2_TX_PORT), USART2_TX_PIN);
-#endif /* USART2_TX */
-
-#if USART2_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART2_RX_PORT), USART2_RX_PIN);
-#endif /* USART2_RX */
-
-#if USART2_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART2_CTS_PORT), USART2_CTS_PIN);
-#endif /* USART2_USART2_CTS */
-
-#if USART2_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART2_RTS_PORT), USART2_RTS_PIN);
-#endif /* USART2_RTS */
-
-#if USART2_IT_ENABLE
-    HAL_NVIC_DisableIRQ(USART2_IRQn);
-#endif /* USART2_IT_ENABLE */
-
-#if USART2_RX_DMA
-
-    HAL_DMA_Abort(&usart2_dmarx_handle);
-    CSP_FREE(usart2_rx_fifo.recv_buf);
-    CSP_FREE(usart2_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(usart2_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&usart2_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART2_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&usart2_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&usart2_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    usart2_handle.hdmarx = NULL;
-
-#endif /* USART2_RX_DMA */
-
-#if USART2_TX_DMA
-    HAL_DMA_Abort(&usart2_dmatx_handle);
-    CSP_FREE(usart2_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&usart2_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART2_TX_DMA_IRQn);
-
-    usart2_handle.hdmatx = NULL;
-#endif /* USART2_TX_DMA */
-
-    if (HAL_UART_DeInit(&usart2_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* USART2_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup USART3 Functions
- * @{
- */
-
-#if USART3_ENABLE
-
-UART_HandleTypeDef usart3_handle = {.Instance = USART3,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if USART3_RX_DMA
-
-static DMA_HandleTypeDef usart3_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(USART3_RX_DMA_NUMBER, USART3_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART3_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART3_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t usart3_rx_fifo = {.buf_size = USART3_RX_DMA_BUF_SIZE,
-                                        .fifo_size = USART3_RX_DMA_FIFO_SIZE};
-
-#endif /* USART3_RX_DMA */
-
-#if USART3_TX_DMA
-
-static DMA_HandleTypeDef usart3_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(USART3_TX_DMA_NUMBER, USART3_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART3_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART3_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t usart3_tx_buf = {.buf_size = USART3_TX_DMA_BUF_SIZE};
-
-#endif /* USART3_TX_DMA */
-
-/**
- * @brief USART3 initialization
- *
- * @param baud_rate Baud rate.
- * @return USART3 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t usart3_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&usart3_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    usart3_handle.Init.BaudRate = baud_rate;
-#if USART3_TX
-    usart3_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(USART3_TX_PORT);
-    gpio_init_struct.Pin = USART3_TX_PIN;
-    gpio_init_struct.Alternate = USART3_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART3_TX_PORT), &gpio_init_struct);
-#endif /* USART3_TX */
-
-#if USART3_RX
-    usart3_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(USART3_RX_PORT);
-    gpio_init_struct.Pin = USART3_RX_PIN;
-    gpio_init_struct.Alternate = USART3_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART3_RX_PORT), &gpio_init_struct);
-#endif /* USART3_RX */
-
-#if USART3_CTS
-    usart3_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
-
-    CSP_GPIO_CLK_ENABLE(USART3_CTS_PORT);
-    gpio_init_struct.Pin = USART3_CTS_PIN;
-    gpio_init_struct.Alternate = USART3_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART3_CTS_PORT), &gpio_init_struct);
-#endif /* USART3_USART3_CTS */
-
-#if USART3_RTS
-    usart3_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(USART3_RTS_PORT);
-    gpio_init_struct.Pin = USART3_RTS_PIN;
-    gpio_init_struct.Alternate = USART3_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART3_RTS_PORT), &gpio_init_struct);
-#endif /* USART3_RTS */
-
-    __HAL_RCC_USART3_CLK_ENABLE();
-#if USART3_IT_ENABLE
-    HAL_NVIC_EnableIRQ(USART3_IRQn);
-    HAL_NVIC_SetPriority(USART3_IRQn, USART3_IT_PRIORITY, USART3_IT_SUB);
-#endif /* USART3_IT_ENABLE */
-
-#if USART3_RX_DMA
-    usart3_rx_fifo.head_ptr = 0;
-
-    usart3_rx_fifo.recv_buf = CSP_MALLOC(usart3_rx_fifo.buf_size);
-    if (usart3_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart3_rx_fifo.rx_fifo_buf = CSP_MALLOC(usart3_rx_fifo.fifo_size);
-    if (usart3_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart3_rx_fifo.rx_fifo = ring_fifo_init(
-        usart3_rx_fifo.rx_fifo_buf, usart3_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (usart3_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART3_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart3_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart3_handle, hdmarx, usart3_dmarx_handle);
-
-    HAL_NVIC_SetPriority(USART3_RX_DMA_IRQn, USART3_RX_DMA_IT_PRIORITY, USART3_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART3_RX_DMA_IRQn);
-
-#endif /* USART3_RX_DMA */
-
-#if USART3_TX_DMA
-    usart3_tx_buf.send_buf = CSP_MALLOC(usart3_tx_buf.buf_size);
-    if (usart3_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART3_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart3_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart3_handle, hdmatx, usart3_dmatx_handle);
-
-    HAL_NVIC_SetPriority(USART3_TX_DMA_IRQn, USART3_TX_DMA_IT_PRIORITY, USART3_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART3_TX_DMA_IRQn);
-
-#endif /* USART3_TX_DMA */
-
-    if (HAL_UART_Init(&usart3_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if USART3_RX_DMA
-    __HAL_UART_ENABLE_IT(&usart3_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&usart3_handle);
-
-    HAL_UART_Receive_DMA(&usart3_handle, usart3_rx_fifo.recv_buf,
-                         usart3_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&usart3_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&usart3_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* USART3_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if USART3_IT_ENABLE
-
-/**
- * @brief USART3 ISR
- *
- */
-void USART3_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&usart3_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&usart3_handle);
-        uart_dmarx_idle_callback(&usart3_handle);
-    }
-
-    HAL_UART_IRQHandler(&usart3_handle);
-}
-
-#endif /* USART3_IT_ENABLE */
-
-#if USART3_RX_DMA
-
-/**
- * @brief USART3 Rx DMA ISR
- *
- */
-void USART3_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart3_dmarx_handle);
-}
-
-#endif /* USART3_RX_DMA */
-
-#if USART3_TX_DMA
-
-/**
- * @brief USART3 Rx DMA ISR
- *
- */
-void USART3_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart3_dmatx_handle);
-}
-
-#endif /* USART3_TX_DMA */
-
-/**
- * @brief USART3 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t usart3_deinit(void) {
-    if (HAL_UART_GetState(&usart3_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_USART3_CLK_DISABLE();
-
-#if USART3_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART3_TX_PORT), USART3_TX_PIN);
-#endif /* USART3_TX */
-
-#if USART3_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART3_RX_PORT), USART3_RX_PIN);
-#endif /* USART3_RX */
-
-#if USART3_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART3_CTS_PORT), USART3_CTS_PIN);
-#endif /* USART3_USART3_CTS */
-
-#if USART3_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART3_RTS_PORT), USART3_RTS_PIN);
-#endif /* USART3_RTS */
-
-#if USART3_IT_ENABLE
-    HAL_NVIC_DisableIRQ(USART3_IRQn);
-#endif /* USART3_IT_ENABLE */
-
-#if USART3_RX_DMA
-
-    HAL_DMA_Abort(&usart3_dmarx_handle);
-    CSP_FREE(usart3_rx_fifo.recv_buf);
-    CSP_FREE(usart3_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(usart3_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&usart3_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART3_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&usart3_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&usart3_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    usart3_handle.hdmarx = NULL;
-
-#endif /* USART3_RX_DMA */
-
-#if USART3_TX_DMA
-    HAL_DMA_Abort(&usart3_dmatx_handle);
-    CSP_FREE(usart3_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&usart3_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART3_TX_DMA_IRQn);
-
-    usart3_handle.hdmatx = NULL;
-#endif /* USART3_TX_DMA */
-
-    if (HAL_UART_DeInit(&usart3_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* USART3_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART4 Functions
- * @{
- */
-
-#if UART4_ENABLE
-
-UART_HandleTypeDef uart4_handle = {.Instance = UART4,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART4_RX_DMA
-
-static DMA_HandleTypeDef uart4_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART4_RX_DMA_NUMBER, UART4_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART4_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART4_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart4_rx_fifo = {.buf_size = UART4_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART4_RX_DMA_FIFO_SIZE};
-
-#endif /* UART4_RX_DMA */
-
-#if UART4_TX_DMA
-
-static DMA_HandleTypeDef uart4_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART4_TX_DMA_NUMBER, UART4_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART4_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART4_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart4_tx_buf = {.buf_size = UART4_TX_DMA_BUF_SIZE};
-
-#endif /* UART4_TX_DMA */
-
-/**
- * @brief UART4 initialization
- *
- * @param baud_rate Baud rate.
- * @return UART4 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t uart4_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart4_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart4_handle.Init.BaudRate = baud_rate;
-#if UART4_TX
-    uart4_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART4_TX_PORT);
-    gpio_init_struct.Pin = UART4_TX_PIN;
-    gpio_init_struct.Alternate = UART4_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART4_TX_PORT), &gpio_init_struct);
-#endif /* UART4_TX */
-
-#if UART4_RX
-    uart4_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART4_RX_PORT);
-    gpio_init_struct.Pin = UART4_RX_PIN;
-    gpio_init_struct.Alternate = UART4_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART4_RX_PORT), &gpio_init_struct);
-#endif /* UART4_RX */
-
-#if UART4_CTS
-    uart4_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
-
-    CSP_GPIO_CLK_ENABLE(UART4_CTS_PORT);
-    gpio_init_struct.Pin = UART4_CTS_PIN;
-    gpio_init_struct.Alternate = UART4_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART4_CTS_PORT), &gpio_init_struct);
-#endif /* UART4_UART4_CTS */
-
-#if UART4_RTS
-    uart4_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(UART4_RTS_PORT);
-    gpio_init_struct.Pin = UART4_RTS_PIN;
-    gpio_init_struct.Alternate = UART4_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART4_RTS_PORT), &gpio_init_struct);
-#endif /* UART4_RTS */
-
-    __HAL_RCC_UART4_CLK_ENABLE();
-#if UART4_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART4_IRQn);
-    HAL_NVIC_SetPriority(UART4_IRQn, UART4_IT_PRIORITY, UART4_IT_SUB);
-#endif /* UART4_IT_ENABLE */
-
-#if UART4_RX_DMA
-    uart4_rx_fifo.head_ptr = 0;
-
-    uart4_rx_fifo.recv_buf = CSP_MALLOC(uart4_rx_fifo.buf_size);
-    if (uart4_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart4_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart4_rx_fifo.fifo_size);
-    if (uart4_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart4_rx_fifo.rx_fifo = ring_fifo_init(
-        uart4_rx_fifo.rx_fifo_buf, uart4_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart4_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART4_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart4_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart4_handle, hdmarx, uart4_dmarx_handle);
-
-    HAL_NVIC_SetPriority(UART4_RX_DMA_IRQn, UART4_RX_DMA_IT_PRIORITY, UART4_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART4_RX_DMA_IRQn);
-
-#endif /* UART4_RX_DMA */
-
-#if UART4_TX_DMA
-    uart4_tx_buf.send_buf = CSP_MALLOC(uart4_tx_buf.buf_size);
-    if (uart4_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART4_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart4_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart4_handle, hdmatx, uart4_dmatx_handle);
-
-    HAL_NVIC_SetPriority(UART4_TX_DMA_IRQn, UART4_TX_DMA_IT_PRIORITY, UART4_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART4_TX_DMA_IRQn);
-
-#endif /* UART4_TX_DMA */
-
-    if (HAL_UART_Init(&uart4_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if UART4_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart4_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart4_handle);
-
-    HAL_UART_Receive_DMA(&uart4_handle, uart4_rx_fifo.recv_buf,
-                         uart4_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart4_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart4_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART4_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if UART4_IT_ENABLE
-
-/**
- * @brief UART4 ISR
- *
- */
-void UART4_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart4_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart4_handle);
-        uart_dmarx_idle_callback(&uart4_handle);
-    }
-
-    HAL_UART_IRQHandler(&uart4_handle);
-}
-
-#endif /* UART4_IT_ENABLE */
-
-#if UART4_RX_DMA
-
-/**
- * @brief UART4 Rx DMA ISR
- *
- */
-void UART4_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart4_dmarx_handle);
-}
-
-#endif /* UART4_RX_DMA */
-
-#if UART4_TX_DMA
-
-/**
- * @brief UART4 Rx DMA ISR
- *
- */
-void UART4_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart4_dmatx_handle);
-}
-
-#endif /* UART4_TX_DMA */
-
-/**
- * @brief UART4 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t uart4_deinit(void) {
-    if (HAL_UART_GetState(&uart4_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_UART4_CLK_DISABLE();
-
-#if UART4_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART4_TX_PORT), UART4_TX_PIN);
-#endif /* UART4_TX */
-
-#if UART4_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART4_RX_PORT), UART4_RX_PIN);
-#endif /* UART4_RX */
-
-#if UART4_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART4_CTS_PORT), UART4_CTS_PIN);
-#endif /* UART4_UART4_CTS */
-
-#if UART4_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART4_RTS_PORT), UART4_RTS_PIN);
-#endif /* UART4_RTS */
-
-#if UART4_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART4_IRQn);
-#endif /* UART4_IT_ENABLE */
-
-#if UART4_RX_DMA
-
-    HAL_DMA_Abort(&uart4_dmarx_handle);
-    CSP_FREE(uart4_rx_fifo.recv_buf);
-    CSP_FREE(uart4_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart4_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&uart4_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART4_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart4_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart4_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart4_handle.hdmarx = NULL;
-
-#endif /* UART4_RX_DMA */
-
-#if UART4_TX_DMA
-    HAL_DMA_Abort(&uart4_dmatx_handle);
-    CSP_FREE(uart4_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&uart4_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART4_TX_DMA_IRQn);
-
-    uart4_handle.hdmatx = NULL;
-#endif /* UART4_TX_DMA */
-
-    if (HAL_UART_DeInit(&uart4_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* UART4_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART5 Functions
- * @{
- */
-
-#if UART5_ENABLE
-
-UART_HandleTypeDef uart5_handle = {.Instance = UART5,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART5_RX_DMA
-
-static DMA_HandleTypeDef uart5_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART5_RX_DMA_NUMBER, UART5_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART5_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART5_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart5_rx_fifo = {.buf_size = UART5_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART5_RX_DMA_FIFO_SIZE};
-
-#endif /* UART5_RX_DMA */
-
-#if UART5_TX_DMA
-
-static DMA_HandleTypeDef uart5_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART5_TX_DMA_NUMBER, UART5_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART5_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART5_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart5_tx_buf = {.buf_size = UART5_TX_DMA_BUF_SIZE};
-
-#endif /* UART5_TX_DMA */
-
-/**
- * @brief UART5 initialization
- *
- * @param baud_rate Baud rate.
- * @return UART5 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t uart5_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart5_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart5_handle.Init.BaudRate = baud_rate;
-#if UART5_TX
-    uart5_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART5_TX_PORT);
-    gpio_init_struct.Pin = UART5_TX_PIN;
-    gpio_init_struct.Alternate = UART5_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART5_TX_PORT), &gpio_init_struct);
-#endif /* UART5_TX */
-
-#if UART5_RX
-    uart5_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART5_RX_PORT);
-    gpio_init_struct.Pin = UART5_RX_PIN;
-    gpio_init_struct.Alternate = UART5_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART5_RX_PORT), &gpio_init_struct);
-#endif /* UART5_RX */
-
-#if UART5_CTS
-    uart5_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
-
-    CSP_GPIO_CLK_ENABLE(UART5_CTS_PORT);
-    gpio_init_struct.Pin = UART5_CTS_PIN;
-    gpio_init_struct.Alternate = UART5_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART5_CTS_PORT), &gpio_init_struct);
-#endif /* UART5_UART5_CTS */
-
-#if UART5_RTS
-    uart5_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(UART5_RTS_PORT);
-    gpio_init_struct.Pin = UART5_RTS_PIN;
-    gpio_init_struct.Alternate = UART5_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART5_RTS_PORT), &gpio_init_struct);
-#endif /* UART5_RTS */
-
-    __HAL_RCC_UART5_CLK_ENABLE();
-#if UART5_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART5_IRQn);
-    HAL_NVIC_SetPriority(UART5_IRQn, UART5_IT_PRIORITY, UART5_IT_SUB);
-#endif /* UART5_IT_ENABLE */
-
-#if UART5_RX_DMA
-    uart5_rx_fifo.head_ptr = 0;
-
-    uart5_rx_fifo.recv_buf = CSP_MALLOC(uart5_rx_fifo.buf_size);
-    if (uart5_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart5_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart5_rx_fifo.fifo_size);
-    if (uart5_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart5_rx_fifo.rx_fifo = ring_fifo_init(
-        uart5_rx_fifo.rx_fifo_buf, uart5_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart5_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART5_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart5_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart5_handle, hdmarx, uart5_dmarx_handle);
-
-    HAL_NVIC_SetPriority(UART5_RX_DMA_IRQn, UART5_RX_DMA_IT_PRIORITY, UART5_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART5_RX_DMA_IRQn);
-
-#endif /* UART5_RX_DMA */
-
-#if UART5_TX_DMA
-    uart5_tx_buf.send_buf = CSP_MALLOC(uart5_tx_buf.buf_size);
-    if (uart5_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART5_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart5_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart5_handle, hdmatx, uart5_dmatx_handle);
-
-    HAL_NVIC_SetPriority(UART5_TX_DMA_IRQn, UART5_TX_DMA_IT_PRIORITY, UART5_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART5_TX_DMA_IRQn);
-
-#endif /* UART5_TX_DMA */
-
-    if (HAL_UART_Init(&uart5_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if UART5_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart5_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart5_handle);
-
-    HAL_UART_Receive_DMA(&uart5_handle, uart5_rx_fifo.recv_buf,
-                         uart5_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart5_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart5_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART5_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if UART5_IT_ENABLE
-
-/**
- * @brief UART5 ISR
- *
- */
-void UART5_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart5_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart5_handle);
-        uart_dmarx_idle_callback(&uart5_handle);
-    }
-
-    HAL_UART_IRQHandler(&uart5_handle);
-}
-
-#endif /* UART5_IT_ENABLE */
-
-#if UART5_RX_DMA
-
-/**
- * @brief UART5 Rx DMA ISR
- *
- */
-void UART5_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart5_dmarx_handle);
-}
-
-#endif /* UART5_RX_DMA */
-
-#if UART5_TX_DMA
-
-/**
- * @brief UART5 Rx DMA ISR
- *
- */
-void UART5_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart5_dmatx_handle);
-}
-
-#endif /* UART5_TX_DMA */
-
-/**
- * @brief UART5 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t uart5_deinit(void) {
-    if (HAL_UART_GetState(&uart5_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_UART5_CLK_DISABLE();
-
-#if UART5_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART5_TX_PORT), UART5_TX_PIN);
-#endif /* UART5_TX */
-
-#if UART5_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART5_RX_PORT), UART5_RX_PIN);
-#endif /* UART5_RX */
-
-#if UART5_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART5_CTS_PORT), UART5_CTS_PIN);
-#endif /* UART5_UART5_CTS */
-
-#if UART5_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART5_RTS_PORT), UART5_RTS_PIN);
-#endif /* UART5_RTS */
-
-#if UART5_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART5_IRQn);
-#endif /* UART5_IT_ENABLE */
-
-#if UART5_RX_DMA
-
-    HAL_DMA_Abort(&uart5_dmarx_handle);
-    CSP_FREE(uart5_rx_fifo.recv_buf);
-    CSP_FREE(uart5_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart5_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&uart5_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART5_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart5_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart5_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart5_handle.hdmarx = NULL;
-
-#endif /* UART5_RX_DMA */
-
-#if UART5_TX_DMA
-    HAL_DMA_Abort(&uart5_dmatx_handle);
-    CSP_FREE(uart5_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&uart5_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART5_TX_DMA_IRQn);
-
-    uart5_handle.hdmatx = NULL;
-#endif /* UART5_TX_DMA */
-
-    if (HAL_UART_DeInit(&uart5_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* UART5_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup USART6 Functions
- * @{
- */
-
-#if USART6_ENABLE
-
-UART_HandleTypeDef usart6_handle = {.Instance = USART6,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if USART6_RX_DMA
-
-static DMA_HandleTypeDef usart6_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(USART6_RX_DMA_NUMBER, USART6_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART6_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART6_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t usart6_rx_fifo = {.buf_size = USART6_RX_DMA_BUF_SIZE,
-                                        .fifo_size = USART6_RX_DMA_FIFO_SIZE};
-
-#endif /* USART6_RX_DMA */
-
-#if USART6_TX_DMA
-
-static DMA_HandleTypeDef usart6_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(USART6_TX_DMA_NUMBER, USART6_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(USART6_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(USART6_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t usart6_tx_buf = {.buf_size = USART6_TX_DMA_BUF_SIZE};
-
-#endif /* USART6_TX_DMA */
-
-/**
- * @brief USART6 initialization
- *
- * @param baud_rate Baud rate.
- * @return USART6 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t usart6_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&usart6_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    usart6_handle.Init.BaudRate = baud_rate;
-#if USART6_TX
-    usart6_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(USART6_TX_PORT);
-    gpio_init_struct.Pin = USART6_TX_PIN;
-    gpio_init_struct.Alternate = USART6_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART6_TX_PORT), &gpio_init_struct);
-#endif /* USART6_TX */
-
-#if USART6_RX
-    usart6_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(USART6_RX_PORT);
-    gpio_init_struct.Pin = USART6_RX_PIN;
-    gpio_init_struct.Alternate = USART6_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART6_RX_PORT), &gpio_init_struct);
-#endif /* USART6_RX */
-
-#if USART6_CTS
-    usart6_handle.Init.HwFlowCtl |= UART_HWCONTROL_CTS;
-
-    CSP_GPIO_CLK_ENABLE(USART6_CTS_PORT);
-    gpio_init_struct.Pin = USART6_CTS_PIN;
-    gpio_init_struct.Alternate = USART6_CTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART6_CTS_PORT), &gpio_init_struct);
-#endif /* USART6_USART6_CTS */
-
-#if USART6_RTS
-    usart6_handle.Init.HwFlowCtl |= UART_HWCONTROL_RTS;
-
-    CSP_GPIO_CLK_ENABLE(USART6_RTS_PORT);
-    gpio_init_struct.Pin = USART6_RTS_PIN;
-    gpio_init_struct.Alternate = USART6_RTS_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(USART6_RTS_PORT), &gpio_init_struct);
-#endif /* USART6_RTS */
-
-    __HAL_RCC_USART6_CLK_ENABLE();
-#if USART6_IT_ENABLE
-    HAL_NVIC_EnableIRQ(USART6_IRQn);
-    HAL_NVIC_SetPriority(USART6_IRQn, USART6_IT_PRIORITY, USART6_IT_SUB);
-#endif /* USART6_IT_ENABLE */
-
-#if USART6_RX_DMA
-    usart6_rx_fifo.head_ptr = 0;
-
-    usart6_rx_fifo.recv_buf = CSP_MALLOC(usart6_rx_fifo.buf_size);
-    if (usart6_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart6_rx_fifo.rx_fifo_buf = CSP_MALLOC(usart6_rx_fifo.fifo_size);
-    if (usart6_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    usart6_rx_fifo.rx_fifo = ring_fifo_init(
-        usart6_rx_fifo.rx_fifo_buf, usart6_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (usart6_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART6_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart6_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart6_handle, hdmarx, usart6_dmarx_handle);
-
-    HAL_NVIC_SetPriority(USART6_RX_DMA_IRQn, USART6_RX_DMA_IT_PRIORITY, USART6_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART6_RX_DMA_IRQn);
-
-#endif /* USART6_RX_DMA */
-
-#if USART6_TX_DMA
-    usart6_tx_buf.send_buf = CSP_MALLOC(usart6_tx_buf.buf_size);
-    if (usart6_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(USART6_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&usart6_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&usart6_handle, hdmatx, usart6_dmatx_handle);
-
-    HAL_NVIC_SetPriority(USART6_TX_DMA_IRQn, USART6_TX_DMA_IT_PRIORITY, USART6_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(USART6_TX_DMA_IRQn);
-
-#endif /* USART6_TX_DMA */
-
-    if (HAL_UART_Init(&usart6_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if USART6_RX_DMA
-    __HAL_UART_ENABLE_IT(&usart6_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&usart6_handle);
-
-    HAL_UART_Receive_DMA(&usart6_handle, usart6_rx_fifo.recv_buf,
-                         usart6_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&usart6_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&usart6_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* USART6_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if USART6_IT_ENABLE
-
-/**
- * @brief USART6 ISR
- *
- */
-void USART6_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&usart6_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&usart6_handle);
-        uart_dmarx_idle_callback(&usart6_handle);
-    }
-
-    HAL_UART_IRQHandler(&usart6_handle);
-}
-
-#endif /* USART6_IT_ENABLE */
-
-#if USART6_RX_DMA
-
-/**
- * @brief USART6 Rx DMA ISR
- *
- */
-void USART6_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart6_dmarx_handle);
-}
-
-#endif /* USART6_RX_DMA */
-
-#if USART6_TX_DMA
-
-/**
- * @brief USART6 Rx DMA ISR
- *
- */
-void USART6_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&usart6_dmatx_handle);
-}
-
-#endif /* USART6_TX_DMA */
-
-/**
- * @brief USART6 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t usart6_deinit(void) {
-    if (HAL_UART_GetState(&usart6_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_USART6_CLK_DISABLE();
-
-#if USART6_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART6_TX_PORT), USART6_TX_PIN);
-#endif /* USART6_TX */
-
-#if USART6_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART6_RX_PORT), USART6_RX_PIN);
-#endif /* USART6_RX */
-
-#if USART6_CTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART6_CTS_PORT), USART6_CTS_PIN);
-#endif /* USART6_USART6_CTS */
-
-#if USART6_RTS
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(USART6_RTS_PORT), USART6_RTS_PIN);
-#endif /* USART6_RTS */
-
-#if USART6_IT_ENABLE
-    HAL_NVIC_DisableIRQ(USART6_IRQn);
-#endif /* USART6_IT_ENABLE */
-
-#if USART6_RX_DMA
-
-    HAL_DMA_Abort(&usart6_dmarx_handle);
-    CSP_FREE(usart6_rx_fifo.recv_buf);
-    CSP_FREE(usart6_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(usart6_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&usart6_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART6_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&usart6_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&usart6_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    usart6_handle.hdmarx = NULL;
-
-#endif /* USART6_RX_DMA */
-
-#if USART6_TX_DMA
-    HAL_DMA_Abort(&usart6_dmatx_handle);
-    CSP_FREE(usart6_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&usart6_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(USART6_TX_DMA_IRQn);
-
-    usart6_handle.hdmatx = NULL;
-#endif /* USART6_TX_DMA */
-
-    if (HAL_UART_DeInit(&usart6_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* USART6_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART7 Functions
- * @{
- */
-
-#if UART7_ENABLE
-
-UART_HandleTypeDef uart7_handle = {.Instance = UART7,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART7_RX_DMA
-
-static DMA_HandleTypeDef uart7_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART7_RX_DMA_NUMBER, UART7_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART7_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART7_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart7_rx_fifo = {.buf_size = UART7_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART7_RX_DMA_FIFO_SIZE};
-
-#endif /* UART7_RX_DMA */
-
-#if UART7_TX_DMA
-
-static DMA_HandleTypeDef uart7_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART7_TX_DMA_NUMBER, UART7_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART7_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART7_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart7_tx_buf = {.buf_size = UART7_TX_DMA_BUF_SIZE};
-
-#endif /* UART7_TX_DMA */
-
-/**
- * @brief UART7 initialization
- *
- * @param baud_rate Baud rate.
- * @return UART7 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t uart7_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart7_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart7_handle.Init.BaudRate = baud_rate;
-#if UART7_TX
-    uart7_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART7_TX_PORT);
-    gpio_init_struct.Pin = UART7_TX_PIN;
-    gpio_init_struct.Alternate = UART7_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART7_TX_PORT), &gpio_init_struct);
-#endif /* UART7_TX */
-
-#if UART7_RX
-    uart7_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART7_RX_PORT);
-    gpio_init_struct.Pin = UART7_RX_PIN;
-    gpio_init_struct.Alternate = UART7_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART7_RX_PORT), &gpio_init_struct);
-#endif /* UART7_RX */
-
-    __HAL_RCC_UART7_CLK_ENABLE();
-#if UART7_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART7_IRQn);
-    HAL_NVIC_SetPriority(UART7_IRQn, UART7_IT_PRIORITY, UART7_IT_SUB);
-#endif /* UART7_IT_ENABLE */
-
-#if UART7_RX_DMA
-    uart7_rx_fifo.head_ptr = 0;
-
-    uart7_rx_fifo.recv_buf = CSP_MALLOC(uart7_rx_fifo.buf_size);
-    if (uart7_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart7_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart7_rx_fifo.fifo_size);
-    if (uart7_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart7_rx_fifo.rx_fifo = ring_fifo_init(
-        uart7_rx_fifo.rx_fifo_buf, uart7_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart7_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART7_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart7_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart7_handle, hdmarx, uart7_dmarx_handle);
-
-    HAL_NVIC_SetPriority(UART7_RX_DMA_IRQn, UART7_RX_DMA_IT_PRIORITY, UART7_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART7_RX_DMA_IRQn);
-
-#endif /* UART7_RX_DMA */
-
-#if UART7_TX_DMA
-    uart7_tx_buf.send_buf = CSP_MALLOC(uart7_tx_buf.buf_size);
-    if (uart7_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART7_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart7_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart7_handle, hdmatx, uart7_dmatx_handle);
-
-    HAL_NVIC_SetPriority(UART7_TX_DMA_IRQn, UART7_TX_DMA_IT_PRIORITY, UART7_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART7_TX_DMA_IRQn);
-
-#endif /* UART7_TX_DMA */
-
-    if (HAL_UART_Init(&uart7_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if UART7_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart7_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart7_handle);
-
-    HAL_UART_Receive_DMA(&uart7_handle, uart7_rx_fifo.recv_buf,
-                         uart7_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart7_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart7_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART7_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if UART7_IT_ENABLE
-
-/**
- * @brief UART7 ISR
- *
- */
-void UART7_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart7_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart7_handle);
-        uart_dmarx_idle_callback(&uart7_handle);
-    }
-
-    HAL_UART_IRQHandler(&uart7_handle);
-}
-
-#endif /* UART7_IT_ENABLE */
-
-#if UART7_RX_DMA
-
-/**
- * @brief UART7 Rx DMA ISR
- *
- */
-void UART7_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart7_dmarx_handle);
-}
-
-#endif /* UART7_RX_DMA */
-
-#if UART7_TX_DMA
-
-/**
- * @brief UART7 Rx DMA ISR
- *
- */
-void UART7_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart7_dmatx_handle);
-}
-
-#endif /* UART7_TX_DMA */
-
-/**
- * @brief UART7 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t uart7_deinit(void) {
-    if (HAL_UART_GetState(&uart7_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_UART7_CLK_DISABLE();
-
-#if UART7_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART7_TX_PORT), UART7_TX_PIN);
-#endif /* UART7_TX */
-
-#if UART7_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART7_RX_PORT), UART7_RX_PIN);
-#endif /* UART7_RX */
-
-#if UART7_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART7_IRQn);
-#endif /* UART7_IT_ENABLE */
-
-#if UART7_RX_DMA
-
-    HAL_DMA_Abort(&uart7_dmarx_handle);
-    CSP_FREE(uart7_rx_fifo.recv_buf);
-    CSP_FREE(uart7_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart7_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&uart7_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART7_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart7_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart7_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart7_handle.hdmarx = NULL;
-
-#endif /* UART7_RX_DMA */
-
-#if UART7_TX_DMA
-    HAL_DMA_Abort(&uart7_dmatx_handle);
-    CSP_FREE(uart7_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&uart7_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART7_TX_DMA_IRQn);
-
-    uart7_handle.hdmatx = NULL;
-#endif /* UART7_TX_DMA */
-
-    if (HAL_UART_DeInit(&uart7_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* UART7_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART8 Functions
- * @{
- */
-
-#if UART8_ENABLE
-
-UART_HandleTypeDef uart8_handle = {.Instance = UART8,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART8_RX_DMA
-
-static DMA_HandleTypeDef uart8_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART8_RX_DMA_NUMBER, UART8_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART8_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART8_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart8_rx_fifo = {.buf_size = UART8_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART8_RX_DMA_FIFO_SIZE};
-
-#endif /* UART8_RX_DMA */
-
-#if UART8_TX_DMA
-
-static DMA_HandleTypeDef uart8_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART8_TX_DMA_NUMBER, UART8_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART8_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART8_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart8_tx_buf = {.buf_size = UART8_TX_DMA_BUF_SIZE};
-
-#endif /* UART8_TX_DMA */
-
-/**
- * @brief UART8 initialization
- *
- * @param baud_rate Baud rate.
- * @return UART8 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t uart8_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart8_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart8_handle.Init.BaudRate = baud_rate;
-#if UART8_TX
-    uart8_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART8_TX_PORT);
-    gpio_init_struct.Pin = UART8_TX_PIN;
-    gpio_init_struct.Alternate = UART8_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART8_TX_PORT), &gpio_init_struct);
-#endif /* UART8_TX */
-
-#if UART8_RX
-    uart8_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART8_RX_PORT);
-    gpio_init_struct.Pin = UART8_RX_PIN;
-    gpio_init_struct.Alternate = UART8_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART8_RX_PORT), &gpio_init_struct);
-#endif /* UART8_RX */
-
-    __HAL_RCC_UART8_CLK_ENABLE();
-#if UART8_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART8_IRQn);
-    HAL_NVIC_SetPriority(UART8_IRQn, UART8_IT_PRIORITY, UART8_IT_SUB);
-#endif /* UART8_IT_ENABLE */
-
-#if UART8_RX_DMA
-    uart8_rx_fifo.head_ptr = 0;
-
-    uart8_rx_fifo.recv_buf = CSP_MALLOC(uart8_rx_fifo.buf_size);
-    if (uart8_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart8_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart8_rx_fifo.fifo_size);
-    if (uart8_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart8_rx_fifo.rx_fifo = ring_fifo_init(
-        uart8_rx_fifo.rx_fifo_buf, uart8_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart8_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART8_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart8_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart8_handle, hdmarx, uart8_dmarx_handle);
-
-    HAL_NVIC_SetPriority(UART8_RX_DMA_IRQn, UART8_RX_DMA_IT_PRIORITY, UART8_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART8_RX_DMA_IRQn);
-
-#endif /* UART8_RX_DMA */
-
-#if UART8_TX_DMA
-    uart8_tx_buf.send_buf = CSP_MALLOC(uart8_tx_buf.buf_size);
-    if (uart8_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART8_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart8_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart8_handle, hdmatx, uart8_dmatx_handle);
-
-    HAL_NVIC_SetPriority(UART8_TX_DMA_IRQn, UART8_TX_DMA_IT_PRIORITY, UART8_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART8_TX_DMA_IRQn);
-
-#endif /* UART8_TX_DMA */
-
-    if (HAL_UART_Init(&uart8_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if UART8_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart8_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart8_handle);
-
-    HAL_UART_Receive_DMA(&uart8_handle, uart8_rx_fifo.recv_buf,
-                         uart8_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart8_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart8_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART8_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if UART8_IT_ENABLE
-
-/**
- * @brief UART8 ISR
- *
- */
-void UART8_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart8_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart8_handle);
-        uart_dmarx_idle_callback(&uart8_handle);
-    }
-
-    HAL_UART_IRQHandler(&uart8_handle);
-}
-
-#endif /* UART8_IT_ENABLE */
-
-#if UART8_RX_DMA
-
-/**
- * @brief UART8 Rx DMA ISR
- *
- */
-void UART8_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart8_dmarx_handle);
-}
-
-#endif /* UART8_RX_DMA */
-
-#if UART8_TX_DMA
-
-/**
- * @brief UART8 Rx DMA ISR
- *
- */
-void UART8_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart8_dmatx_handle);
-}
-
-#endif /* UART8_TX_DMA */
-
-/**
- * @brief UART8 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t uart8_deinit(void) {
-    if (HAL_UART_GetState(&uart8_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_UART8_CLK_DISABLE();
-
-#if UART8_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART8_TX_PORT), UART8_TX_PIN);
-#endif /* UART8_TX */
-
-#if UART8_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART8_RX_PORT), UART8_RX_PIN);
-#endif /* UART8_RX */
-
-#if UART8_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART8_IRQn);
-#endif /* UART8_IT_ENABLE */
-
-#if UART8_RX_DMA
-
-    HAL_DMA_Abort(&uart8_dmarx_handle);
-    CSP_FREE(uart8_rx_fifo.recv_buf);
-    CSP_FREE(uart8_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart8_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&uart8_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART8_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart8_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart8_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart8_handle.hdmarx = NULL;
-
-#endif /* UART8_RX_DMA */
-
-#if UART8_TX_DMA
-    HAL_DMA_Abort(&uart8_dmatx_handle);
-    CSP_FREE(uart8_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&uart8_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART8_TX_DMA_IRQn);
-
-    uart8_handle.hdmatx = NULL;
-#endif /* UART8_TX_DMA */
-
-    if (HAL_UART_DeInit(&uart8_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* UART8_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART9 Functions
- * @{
- */
-
-#if UART9_ENABLE
-
-UART_HandleTypeDef uart9_handle = {.Instance = UART9,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART9_RX_DMA
-
-static DMA_HandleTypeDef uart9_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART9_RX_DMA_NUMBER, UART9_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART9_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART9_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart9_rx_fifo = {.buf_size = UART9_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART9_RX_DMA_FIFO_SIZE};
-
-#endif /* UART9_RX_DMA */
-
-#if UART9_TX_DMA
-
-static DMA_HandleTypeDef uart9_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART9_TX_DMA_NUMBER, UART9_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART9_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART9_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart9_tx_buf = {.buf_size = UART9_TX_DMA_BUF_SIZE};
-
-#endif /* UART9_TX_DMA */
-
-/**
- * @brief UART9 initialization
- *
- * @param baud_rate Baud rate.
- * @return UART9 init status.
- * @retval - 0: `UART_INIT_OK`:       Success.
- * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
- * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
- * @retval - 3: `UART_INIT_MEM_FAIL`: UART buffer memory init failed (It will
- *                                    dynamic allocate memory when using DMA).
- * @retval - 4: `UART_INITED`:        This uart is inited.
- */
-uint8_t uart9_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart9_handle) != RESET) {
-        return UART_INITED;
-    }
-
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart9_handle.Init.BaudRate = baud_rate;
-#if UART9_TX
-    uart9_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART9_TX_PORT);
-    gpio_init_struct.Pin = UART9_TX_PIN;
-    gpio_init_struct.Alternate = UART9_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART9_TX_PORT), &gpio_init_struct);
-#endif /* UART9_TX */
-
-#if UART9_RX
-    uart9_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART9_RX_PORT);
-    gpio_init_struct.Pin = UART9_RX_PIN;
-    gpio_init_struct.Alternate = UART9_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART9_RX_PORT), &gpio_init_struct);
-#endif /* UART9_RX */
-
-    __HAL_RCC_UART9_CLK_ENABLE();
-#if UART9_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART9_IRQn);
-    HAL_NVIC_SetPriority(UART9_IRQn, UART9_IT_PRIORITY, UART9_IT_SUB);
-#endif /* UART9_IT_ENABLE */
-
-#if UART9_RX_DMA
-    uart9_rx_fifo.head_ptr = 0;
-
-    uart9_rx_fifo.recv_buf = CSP_MALLOC(uart9_rx_fifo.buf_size);
-    if (uart9_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart9_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart9_rx_fifo.fifo_size);
-    if (uart9_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    uart9_rx_fifo.rx_fifo = ring_fifo_init(
-        uart9_rx_fifo.rx_fifo_buf, uart9_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart9_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART9_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart9_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart9_handle, hdmarx, uart9_dmarx_handle);
-
-    HAL_NVIC_SetPriority(UART9_RX_DMA_IRQn, UART9_RX_DMA_IT_PRIORITY, UART9_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART9_RX_DMA_IRQn);
-
-#endif /* UART9_RX_DMA */
-
-#if UART9_TX_DMA
-    uart9_tx_buf.send_buf = CSP_MALLOC(uart9_tx_buf.buf_size);
-    if (uart9_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
-
-    CSP_DMA_CLK_ENABLE(UART9_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart9_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
-
-    __HAL_LINKDMA(&uart9_handle, hdmatx, uart9_dmatx_handle);
-
-    HAL_NVIC_SetPriority(UART9_TX_DMA_IRQn, UART9_TX_DMA_IT_PRIORITY, UART9_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART9_TX_DMA_IRQn);
-
-#endif /* UART9_TX_DMA */
-
-    if (HAL_UART_Init(&uart9_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
-    }
-    
-#if UART9_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart9_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart9_handle);
-
-    HAL_UART_Receive_DMA(&uart9_handle, uart9_rx_fifo.recv_buf,
-                         uart9_rx_fifo.buf_size);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart9_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart9_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART9_RX_DMA */
-    return UART_INIT_OK;
-}
-
-#if UART9_IT_ENABLE
-
-/**
- * @brief UART9 ISR
- *
- */
-void UART9_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart9_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart9_handle);
-        uart_dmarx_idle_callback(&uart9_handle);
-    }
-
-    HAL_UART_IRQHandler(&uart9_handle);
-}
-
-#endif /* UART9_IT_ENABLE */
-
-#if UART9_RX_DMA
-
-/**
- * @brief UART9 Rx DMA ISR
- *
- */
-void UART9_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart9_dmarx_handle);
-}
-
-#endif /* UART9_RX_DMA */
-
-#if UART9_TX_DMA
-
-/**
- * @brief UART9 Rx DMA ISR
- *
- */
-void UART9_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart9_dmatx_handle);
-}
-
-#endif /* UART9_TX_DMA */
-
-/**
- * @brief UART9 deinitialization.
- *
- * @return UART deinit status.
- * @retval - 0: `UART_DEINIT_OK`:       Success.
- * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
- * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
- * @retval - 3: `UART_NO_INIT`:         UART is not init.
- */
-uint8_t uart9_deinit(void) {
-    if (HAL_UART_GetState(&uart9_handle) == RESET) {
-        return UART_NO_INIT;
-    }
-
-    __HAL_RCC_UART9_CLK_DISABLE();
-
-#if UART9_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART9_TX_PORT), UART9_TX_PIN);
-#endif /* UART9_TX */
-
-#if UART9_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART9_RX_PORT), UART9_RX_PIN);
-#endif /* UART9_RX */
-
-#if UART9_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART9_IRQn);
-#endif /* UART9_IT_ENABLE */
-
-#if UART9_RX_DMA
-
-    HAL_DMA_Abort(&uart9_dmarx_handle);
-    CSP_FREE(uart9_rx_fifo.recv_buf);
-    CSP_FREE(uart9_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart9_rx_fifo.rx_fifo);
-
-    if (HAL_DMA_DeInit(&uart9_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART9_RX_DMA_IRQn);
-
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart9_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart9_handle, HAL_UART_RX_COMPLETE_CB_ID);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart9_handle.hdmarx = NULL;
-
-#endif /* UART9_RX_DMA */
-
-#if UART9_TX_DMA
-    HAL_DMA_Abort(&uart9_dmatx_handle);
-    CSP_FREE(uart9_tx_buf.send_buf);
-
-    if (HAL_DMA_DeInit(&uart9_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
-
-    HAL_NVIC_DisableIRQ(UART9_TX_DMA_IRQn);
-
-    uart9_handle.hdmatx = NULL;
-#endif /* UART9_TX_DMA */
-
-    if (HAL_UART_DeInit(&uart9_handle) != HAL_OK) {
-        return UART_DEINIT_FAIL;
-    }
-
-    return UART_DEINIT_OK;
-}
-
-#endif /* UART9_ENABLE */
-
-/**
- * @}
- */ 
-
-
-/*****************************************************************************
- * @defgroup UART10 Functions
- * @{
- */
-
-#if UART10_ENABLE
-
-UART_HandleTypeDef uart10_handle = {.Instance = UART10,
-                                    .Init = {.WordLength = UART_WORDLENGTH_8B,
-                                             .StopBits = UART_STOPBITS_1,
-                                             .Parity = UART_PARITY_NONE}};
-
-#if UART10_RX_DMA
-
-static DMA_HandleTypeDef uart10_dmarx_handle = {
-    .Instance = CSP_DMA_STREAM(UART10_RX_DMA_NUMBER, UART10_RX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART10_RX_DMA_CHANNEL),
-             .Direction = DMA_PERIPH_TO_MEMORY,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_CIRCULAR,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART10_RX_DMA_PRIORITY)}};
-
-static uart_rx_fifo_t uart10_rx_fifo = {.buf_size = UART10_RX_DMA_BUF_SIZE,
-                                        .fifo_size = UART10_RX_DMA_FIFO_SIZE};
-
-#endif /* UART10_RX_DMA */
-
-#if UART10_TX_DMA
-
-static DMA_HandleTypeDef uart10_dmatx_handle = {
-    .Instance = CSP_DMA_STREAM(UART10_TX_DMA_NUMBER, UART10_TX_DMA_STREAM),
-    .Init = {.Channel = CSP_DMA_CHANNEL(UART10_TX_DMA_CHANNEL),
-             .Direction = DMA_MEMORY_TO_PERIPH,
-             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
-             .MemInc = DMA_MINC_ENABLE,
-             .Mode = DMA_NORMAL,
-             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
-             .PeriphInc = DMA_PINC_DISABLE,
-             .Priority = CSP_DMA_PRIORITY(UART10_TX_DMA_PRIORITY)}};
-
-static uart_tx_buf_t uart10_tx_buf = {.buf_size = UART10_TX_DMA_BUF_SIZE};
-
-#endif /* UART10_TX_DMA */
+static void uart_port_pin_deinit(const uart_pin_t *pin) {
+    if (pin->port != NULL) {
+        HAL_GPIO_DeInit(pin->port, pin->pin);
+    }
+}
 
 /**
- * @brief UART10 initialization
+ * @brief UART initialization
  *
+ * @param port The driver of UART.
  * @param baud_rate Baud rate.
- * @return UART10 init status.
+ * @return UART init status.
  * @retval - 0: `UART_INIT_OK`:       Success.
  * @retval - 1: `UART_INIT_FAIL`:     UART init failed.
  * @retval - 2: `UART_INIT_DMA_FAIL`: UART DMA init failed.
@@ -2789,224 +298,211 @@ static uart_tx_buf_t uart10_tx_buf = {.buf_size = UART10_TX_DMA_BUF_SIZE};
  *                                    dynamic allocate memory when using DMA).
  * @retval - 4: `UART_INITED`:        This uart is inited.
  */
-uint8_t uart10_init(uint32_t baud_rate) {
-    if (HAL_UART_GetState(&uart10_handle) != RESET) {
+static uint8_t uart_port_init(const uart_port_t *port, uint32_t baud_rate) {
+    UART_HandleTypeDef *huart = port->huart;
+
+    if (HAL_UART_GetState(huart) != RESET) {
         return UART_INITED;
     }
 
-    GPIO_InitTypeDef gpio_init_struct = {.Pull = GPIO_PULLUP,
-                                         .Speed = GPIO_SPEED_FREQ_HIGH,
-                                         .Mode = GPIO_MODE_AF_PP};
-    uart10_handle.Init.BaudRate = baud_rate;
-#if UART10_TX
-    uart10_handle.Init.Mode |= UART_MODE_TX;
-
-    CSP_GPIO_CLK_ENABLE(UART10_TX_PORT);
-    gpio_init_struct.Pin = UART10_TX_PIN;
-    gpio_init_struct.Alternate = UART10_TX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART10_TX_PORT), &gpio_init_struct);
-#endif /* UART10_TX */
-
-#if UART10_RX
-    uart10_handle.Init.Mode |= UART_MODE_RX;
-
-    CSP_GPIO_CLK_ENABLE(UART10_RX_PORT);
-    gpio_init_struct.Pin = UART10_RX_PIN;
-    gpio_init_struct.Alternate = UART10_RX_AF;
-    HAL_GPIO_Init(CSP_GPIO_PORT(UART10_RX_PORT), &gpio_init_struct);
-#endif /* UART10_RX */
-
-    __HAL_RCC_UART10_CLK_ENABLE();
-#if UART10_IT_ENABLE
-    HAL_NVIC_EnableIRQ(UART10_IRQn);
-    HAL_NVIC_SetPriority(UART10_IRQn, UART10_IT_PRIORITY, UART10_IT_SUB);
-#endif /* UART10_IT_ENABLE */
+    port->clk_enable();
 
-#if UART10_RX_DMA
-    uart10_rx_fifo.head_ptr = 0;
-
-    uart10_rx_fifo.recv_buf = CSP_MALLOC(uart10_rx_fifo.buf_size);
-    if (uart10_rx_fifo.recv_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
+    huart->Init.BaudRate = baud_rate;
+    if (port->tx.port != NULL) {
+        huart->Init.Mode |= UART_MODE_TX;
     }
-
-    uart10_rx_fifo.rx_fifo_buf = CSP_MALLOC(uart10_rx_fifo.fifo_size);
-    if (uart10_rx_fifo.rx_fifo_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
+    if (port->rx.port != NULL) {
+        huart->Init.Mode |= UART_MODE_RX;
     }
-
-    uart10_rx_fifo.rx_fifo = ring_fifo_init(
-        uart10_rx_fifo.rx_fifo_buf, uart10_rx_fifo.fifo_size, RF_TYPE_STREAM);
-    if (uart10_rx_fifo.rx_fifo == NULL) {
-        return UART_INIT_MEM_FAIL;
+    if (port->cts.port != NULL) {
+        huart->Init.HwFlowCtl |= UART_HWCONTROL_CTS;
     }
-
-    CSP_DMA_CLK_ENABLE(UART10_RX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart10_dmarx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
+    if (port->rts.port != NULL) {
+        huart->Init.HwFlowCtl |= UART_HWCONTROL_RTS;
     }
 
-    __HAL_LINKDMA(&uart10_handle, hdmarx, uart10_dmarx_handle);
+    uart_port_pin_init(&port->tx);
+    uart_port_pin_init(&port->rx);
+    uart_port_pin_init(&port->cts);
+    uart_port_pin_init(&port->rts);
 
-    HAL_NVIC_SetPriority(UART10_RX_DMA_IRQn, UART10_RX_DMA_IT_PRIORITY, UART10_RX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART10_RX_DMA_IRQn);
+    if (port->irq.enable) {
+        HAL_NVIC_EnableIRQ(port->irq.irqn);
+        HAL_NVIC_SetPriority(port->irq.irqn, port->irq.priority,
+                             port->irq.sub);
+    }
 
-#endif /* UART10_RX_DMA */
+    if (port->dmarx != NULL) {
+        uart_rx_fifo_t *rx_fifo = port->rx_fifo;
+        rx_fifo->head_ptr = 0;
+        rx_fifo->read_ptr = 0;
+        rx_fifo->zero_copy = 0;
 
-#if UART10_TX_DMA
-    uart10_tx_buf.send_buf = CSP_MALLOC(uart10_tx_buf.buf_size);
-    if (uart10_tx_buf.send_buf == NULL) {
-        return UART_INIT_MEM_FAIL;
-    }
+        rx_fifo->recv_buf = CSP_MALLOC(rx_fifo->buf_size);
+        if (rx_fifo->recv_buf == NULL) {
+            return UART_INIT_MEM_FAIL;
+        }
 
-    CSP_DMA_CLK_ENABLE(UART10_TX_DMA_NUMBER);
-    if (HAL_DMA_Init(&uart10_dmatx_handle) != HAL_OK) {
-        return UART_INIT_DMA_FAIL;
-    }
+        rx_fifo->rx_fifo_buf = CSP_MALLOC(rx_fifo->fifo_size);
+        if (rx_fifo->rx_fifo_buf == NULL) {
+            return UART_INIT_MEM_FAIL;
+        }
 
-    __HAL_LINKDMA(&uart10_handle, hdmatx, uart10_dmatx_handle);
+        rx_fifo->rx_fifo = ring_fifo_init(
+            rx_fifo->rx_fifo_buf, rx_fifo->fifo_size, RF_TYPE_STREAM);
+        if (rx_fifo->rx_fifo == NULL) {
+            return UART_INIT_MEM_FAIL;
+        }
 
-    HAL_NVIC_SetPriority(UART10_TX_DMA_IRQn, UART10_TX_DMA_IT_PRIORITY, UART10_TX_DMA_IT_SUB);
-    HAL_NVIC_EnableIRQ(UART10_TX_DMA_IRQn);
+        if (HAL_DMA_Init(port->dmarx) != HAL_OK) {
+            return UART_INIT_DMA_FAIL;
+        }
 
-#endif /* UART10_TX_DMA */
+        __HAL_LINKDMA(huart, hdmarx, *port->dmarx);
 
-    if (HAL_UART_Init(&uart10_handle) != HAL_OK) {
-        return UART_INIT_FAIL;
+        HAL_NVIC_SetPriority(port->dmarx_irq.irqn, port->dmarx_irq.priority,
+                             port->dmarx_irq.sub);
+        HAL_NVIC_EnableIRQ(port->dmarx_irq.irqn);
     }
-    
-#if UART10_RX_DMA
-    __HAL_UART_ENABLE_IT(&uart10_handle, UART_IT_IDLE);
-    __HAL_UART_CLEAR_IDLEFLAG(&uart10_handle);
 
-    HAL_UART_Receive_DMA(&uart10_handle, uart10_rx_fifo.recv_buf,
-                         uart10_rx_fifo.buf_size);
+    if (port->dmatx != NULL) {
+        uart_tx_buf_t *tx_buf = port->tx_buf;
 
-#if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_RegisterCallback(&uart10_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID,
-                              uart_dmarx_halfdone_callback);
-    HAL_UART_RegisterCallback(&uart10_handle, HAL_UART_RX_COMPLETE_CB_ID,
-                              uart_dmarx_done_callback);
-#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-#endif /* UART10_RX_DMA */
-    return UART_INIT_OK;
-}
+        tx_buf->send_buf = CSP_MALLOC(tx_buf->buf_size * 2);
+        if (tx_buf->send_buf == NULL) {
+            return UART_INIT_MEM_FAIL;
+        }
+        uart_dmatx_reset(tx_buf);
 
-#if UART10_IT_ENABLE
+        if (HAL_DMA_Init(port->dmatx) != HAL_OK) {
+            return UART_INIT_DMA_FAIL;
+        }
 
-/**
- * @brief UART10 ISR
- *
- */
-void UART10_IRQHandler(void) {
-    if (__HAL_UART_GET_FLAG(&uart10_handle, UART_FLAG_IDLE)) {
-        __HAL_UART_CLEAR_IDLEFLAG(&uart10_handle);
-        uart_dmarx_idle_callback(&uart10_handle);
-    }
+        __HAL_LINKDMA(huart, hdmatx, *port->dmatx);
 
-    HAL_UART_IRQHandler(&uart10_handle);
-}
+        HAL_NVIC_SetPriority(port->dmatx_irq.irqn, port->dmatx_irq.priority,
+                             port->dmatx_irq.sub);
+        HAL_NVIC_EnableIRQ(port->dmatx_irq.irqn);
+    }
 
-#endif /* UART10_IT_ENABLE */
+    if (HAL_UART_Init(huart) != HAL_OK) {
+        return UART_INIT_FAIL;
+    }
 
-#if UART10_RX_DMA
+    if (port->dmarx != NULL) {
+        __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+        __HAL_UART_CLEAR_IDLEFLAG(huart);
 
-/**
- * @brief UART10 Rx DMA ISR
- *
- */
-void UART10_RX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart10_dmarx_handle);
-}
+        HAL_UART_Receive_DMA(huart, port->rx_fifo->recv_buf,
+                             port->rx_fifo->buf_size);
 
-#endif /* UART10_RX_DMA */
+#if USE_HAL_UART_REGISTER_CALLBACKS
+        HAL_UART_RegisterCallback(huart, HAL_UART_RX_HALFCOMPLETE_CB_ID,
+                                  uart_dmarx_halfdone_callback);
+        HAL_UART_RegisterCallback(huart, HAL_UART_RX_COMPLETE_CB_ID,
+                                  uart_dmarx_done_callback);
+#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
+    }
 
-#if UART10_TX_DMA
+#if USE_HAL_UART_REGISTER_CALLBACKS
+    if (port->dmatx != NULL) {
+        HAL_UART_RegisterCallback(huart, HAL_UART_TX_COMPLETE_CB_ID,
+                                  uart_dmatx_done_callback);
+    }
+#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
 
-/**
- * @brief UART10 Rx DMA ISR
- *
- */
-void UART10_TX_DMA_IRQHandler(void) {
-    HAL_DMA_IRQHandler(&uart10_dmatx_handle);
+    return UART_INIT_OK;
 }
 
-#endif /* UART10_TX_DMA */
-
 /**
- * @brief UART10 deinitialization.
+ * @brief UART deinitialization.
  *
+ * @param port The driver of UART.
  * @return UART deinit status.
  * @retval - 0: `UART_DEINIT_OK`:       Success.
  * @retval - 1: `UART_DEINIT_FAIL`:     UART deinit failed.
  * @retval - 2: `UART_DEINIT_DMA_FAIL`: UART DMA deinit failed.
  * @retval - 3: `UART_NO_INIT`:         UART is not init.
  */
-uint8_t uart10_deinit(void) {
-    if (HAL_UART_GetState(&uart10_handle) == RESET) {
+static uint8_t uart_port_deinit(const uart_port_t *port) {
+    UART_HandleTypeDef *huart = port->huart;
+
+    if (HAL_UART_GetState(huart) == RESET) {
         return UART_NO_INIT;
     }
 
-    __HAL_RCC_UART10_CLK_DISABLE();
-
-#if UART10_TX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART10_TX_PORT), UART10_TX_PIN);
-#endif /* UART10_TX */
-
-#if UART10_RX
-    HAL_GPIO_DeInit(CSP_GPIO_PORT(UART10_RX_PORT), UART10_RX_PIN);
-#endif /* UART10_RX */
+    port->clk_disable();
 
-#if UART10_IT_ENABLE
-    HAL_NVIC_DisableIRQ(UART10_IRQn);
-#endif /* UART10_IT_ENABLE */
+    uart_port_pin_deinit(&port->tx);
+    uart_port_pin_deinit(&port->rx);
+    uart_port_pin_deinit(&port->cts);
+    uart_port_pin_deinit(&port->rts);
 
-#if UART10_RX_DMA
+    if (port->irq.enable) {
+        HAL_NVIC_DisableIRQ(port->irq.irqn);
+    }
 
-    HAL_DMA_Abort(&uart10_dmarx_handle);
-    CSP_FREE(uart10_rx_fifo.recv_buf);
-    CSP_FREE(uart10_rx_fifo.rx_fifo_buf);
-    ring_fifo_destroy(uart10_rx_fifo.rx_fifo);
+    if (port->dmarx != NULL) {
+        HAL_DMA_Abort(port->dmarx);
+        CSP_FREE(port->rx_fifo->recv_buf);
+        CSP_FREE(port->rx_fifo->rx_fifo_buf);
+        ring_fifo_destroy(port->rx_fifo->rx_fifo);
 
-    if (HAL_DMA_DeInit(&uart10_dmarx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
+        if (HAL_DMA_DeInit(port->dmarx) != HAL_OK) {
+            return UART_DEINIT_DMA_FAIL;
+        }
 
-    HAL_NVIC_DisableIRQ(UART10_RX_DMA_IRQn);
+        HAL_NVIC_DisableIRQ(port->dmarx_irq.irqn);
 
 #if USE_HAL_UART_REGISTER_CALLBACKS
-    HAL_UART_UnRegisterCallback(&uart10_handle, HAL_UART_RX_HALFCOMPLETE_CB_ID);
-    HAL_UART_UnRegisterCallback(&uart10_handle, HAL_UART_RX_COMPLETE_CB_ID);
+        HAL_UART_UnRegisterCallback(huart, HAL_UART_RX_HALFCOMPLETE_CB_ID);
+        HAL_UART_UnRegisterCallback(huart, HAL_UART_RX_COMPLETE_CB_ID);
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS */
-    uart10_handle.hdmarx = NULL;
-
-#endif /* UART10_RX_DMA */
+        huart->hdmarx = NULL;
+    }
 
-#if UART10_TX_DMA
-    HAL_DMA_Abort(&uart10_dmatx_handle);
-    CSP_FREE(uart10_tx_buf.send_buf);
+    if (port->dmatx != NULL) {
+        HAL_DMA_Abort(port->dmatx);
+        CSP_FREE(port->tx_buf->send_buf);
 
-    if (HAL_DMA_DeInit(&uart10_dmatx_handle) != HAL_OK) {
-        return UART_DEINIT_DMA_FAIL;
-    }
+        if (HAL_DMA_DeInit(port->dmatx) != HAL_OK) {
+            return UART_DEINIT_DMA_FAIL;
+        }
 
-    HAL_NVIC_DisableIRQ(UART10_TX_DMA_IRQn);
+        HAL_NVIC_DisableIRQ(port->dmatx_irq.irqn);
 
-    uart10_handle.hdmatx = NULL;
-#endif /* UART10_TX_DMA */
+#if USE_HAL_UART_REGISTER_CALLBACKS
+        HAL_UART_UnRegisterCallback(huart, HAL_UART_TX_COMPLETE_CB_ID);
+#endif /* USE_HAL_UART_REGISTER_CALLBACKS */
+        huart->hdmatx = NULL;
+    }
 
-    if (HAL_UART_DeInit(&uart10_handle) != HAL_OK) {
+    if (HAL_UART_DeInit(huart) != HAL_OK) {
         return UART_DEINIT_FAIL;
     }
 
     return UART_DEINIT_OK;
 }
 
-#endif /* UART10_ENABLE */
+/**
+ * @brief UART ISR
+ *
+ * @param port The driver of UART.
+ */
+static void uart_port_irq_handler(const uart_port_t *port) {
+    UART_HandleTypeDef *huart = port->huart;
+
+    if (__HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE)) {
+        __HAL_UART_CLEAR_IDLEFLAG(huart);
+        uart_dmarx_idle_callback(huart);
+    }
+
+    HAL_UART_IRQHandler(huart);
+}
 
 /**
  * @}
- */ 
+ */
 
 /*****************************************************************************
  * @defgroup Public UART functions.
@@ -3031,10 +527,6 @@ int uart_printf(UART_HandleTypeDef *huart, const char *__format, ...) {
         return 0;
     }
 
-    /* Wait for last transfer end. */
-    while (__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) == RESET)
-        ;
-
     va_start(ap, __format);
     res = vsnprintf(uart_buffer, sizeof(uart_buffer), __format, ap);
     va_end(ap);
@@ -3042,7 +534,10 @@ int uart_printf(UART_HandleTypeDef *huart, const char *__format, ...) {
     len = strlen(uart_buffer);
 
     if (huart->hdmatx != NULL) {
-        HAL_UART_Transmit_DMA(huart, (uint8_t *)uart_buffer, len);
+        /* Queue to the send buf, never wait for the last transfer. */
+        if (uart_dmatx_write(huart, uart_buffer, len) != 0) {
+            uart_dmatx_send(huart);
+        }
     } else {
         HAL_UART_Transmit(huart, (uint8_t *)uart_buffer, len, 1000);
     }
@@ -3102,72 +597,8 @@ int uart_scanf(UART_HandleTypeDef *huart, const char *__format, ...) {
  * @return The point of UART rx fifo.
  */
 static inline uart_rx_fifo_t *uart_rx_identify(UART_HandleTypeDef *huart) {
-    switch ((uintptr_t)huart->Instance) {
-
-#if USART1_RX_DMA
-        case USART1_BASE: {
-            return &usart1_rx_fifo;
-        }
-#endif /* USART1_RX_DMA */
-
-#if USART2_RX_DMA
-        case USART2_BASE: {
-            return &usart2_rx_fifo;
-        }
-#endif /* USART2_RX_DMA */
-#if USART3_RX_DMA
-        case USART3_BASE: {
-            return &usart3_rx_fifo;
-        }
-#endif /* USART3_RX_DMA */
-
-#if UART4_RX_DMA
-        case UART4_BASE: {
-            return &uart4_rx_fifo;
-        }
-#endif /* UART4_RX_DMA */
-
-#if UART5_RX_DMA
-        case UART5_BASE: {
-            return &uart5_rx_fifo;
-        }
-#endif /* UART5_RX_DMA */
-
-#if USART6_RX_DMA
-        case USART6_BASE: {
-            return &usart6_rx_fifo;
-        }
-#endif /* USART6_RX_DMA */
-
-#if UART7_RX_DMA
-        case UART7_BASE: {
-            return &uart7_rx_fifo;
-        }
-#endif /* UART7_RX_DMA */
-
-#if UART8_RX_DMA
-        case UART8_BASE: {
-            return &uart8_rx_fifo;
-        }
-#endif /* UART8_RX_DMA */
-
-#if UART9_RX_DMA
-        case UART9_BASE: {
-            return &uart9_rx_fifo;
-        }
-#endif /* UART9_RX_DMA */
-
-#if UART10_RX_DMA
-        case UART10_BASE: {
-            return &uart10_rx_fifo;
-        }
-#endif /* UART10_RX_DMA */
-
-        default: {
-        } break;
-    }
-
-    return NULL;
+    const uart_port_t *port = uart_port_identify(huart);
+    return (port == NULL) ? NULL : port->rx_fifo;
 }
 
 /**
@@ -3200,7 +631,16 @@ void uart_dmarx_idle_callback(UART_HandleTypeDef *huart) {
     copy = tail_ptr - offset;
     uart_rx_fifo->head_ptr += copy;
 
-    ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset, copy);
+    if (copy == 0) {
+        /* The data has been moved by the half/full transfer callback. */
+        return;
+    }
+
+    if (!uart_rx_fifo->zero_copy) {
+        ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset,
+                        copy);
+    }
+    uart_dmarx_rx_event_callback(huart);
 }
 
 /**
@@ -3233,7 +673,11 @@ void uart_dmarx_halfdone_callback(UART_HandleTypeDef *huart) {
     copy = tail_ptr - offset;
     uart_rx_fifo->head_ptr += copy;
 
-    ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset, copy);
+    if (!uart_rx_fifo->zero_copy) {
+        ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset,
+                        copy);
+    }
+    uart_dmarx_rx_event_callback(huart);
 }
 
 /**
@@ -3266,7 +710,11 @@ void uart_dmarx_done_callback(UART_HandleTypeDef *huart) {
     copy = tail_ptr - offset;
     uart_rx_fifo->head_ptr += copy;
 
-    ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset, copy);
+    if (!uart_rx_fifo->zero_copy) {
+        ring_fifo_write(uart_rx_fifo->rx_fifo, huart->pRxBuffPtr + offset,
+                        copy);
+    }
+    uart_dmarx_rx_event_callback(huart);
 
     if (huart->hdmarx->Init.Mode != DMA_CIRCULAR) {
         /* Reopen the DMA receive. */
@@ -3277,6 +725,20 @@ void uart_dmarx_done_callback(UART_HandleTypeDef *huart) {
     }
 }
 
+/**
+ * @brief New data has been written to the receive fifo.
+ *
+ * @param huart The handle of UART
+ * @note Called in the UART and the DMA RX interrupt. Override it to wake up
+ *       the reader instead of polling `uart_dmarx_read`. If it calls the
+ *       FreeRTOS `FromISR` API, the interrupt priority of the UART and the
+ *       DMA RX must not be higher than
+ *       `configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY`.
+ */
+__weak void uart_dmarx_rx_event_callback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+}
+
 /**
  * @brief Read from UART Receive fifo.
  *
@@ -3299,6 +761,107 @@ uint32_t uart_dmarx_read(UART_HandleTypeDef *huart, void *buf,
     return ring_fifo_read(uart_rx_fifo->rx_fifo, buf, buf_size);
 }
 
+/**
+ * @brief Get the count of bytes the DMA has written to the receive buf.
+ *
+ * @param huart The handle of UART
+ * @param uart_rx_fifo The receive fifo of UART.
+ * @return The count, same base as `head_ptr`.
+ * @note `head_ptr` is updated by the idle, half and full transfer callback,
+ *       the DMA is less than one buf ahead of it.
+ */
+static uint32_t uart_dmarx_received(UART_HandleTypeDef *huart,
+                                    uart_rx_fifo_t *uart_rx_fifo) {
+    uint32_t head_ptr = uart_rx_fifo->head_ptr;
+    uint32_t size = huart->RxXferSize;
+    uint32_t tail_ptr = size - __HAL_DMA_GET_COUNTER(huart->hdmarx);
+
+    return head_ptr + (tail_ptr + size - head_ptr % size) % size;
+}
+
+/**
+ * @brief Get the received data in the DMA receive buf without copying.
+ *
+ * @param huart The handle of UART
+ * @param[out] span The data not consumed, `len[1]` is not 0 if the data
+ *                  wraps around.
+ * @return Peek status:
+ * @retval - 0: Success.
+ * @retval - 1: This UART not enable DMA Rx or not init.
+ * @retval - 2: The DMA has overwritten data not consumed, the data is
+ *              dropped and the span starts from the newest data.
+ * @note The first call switches the UART to zero-copy, the callbacks stop
+ *       writing the receive fifo and `uart_dmarx_read` returns nothing.
+ *       Parse the span in place, then call `uart_dmarx_consume`. The span is
+ *       valid until the DMA laps it, so the buf must hold the data received
+ *       while parsing.
+ */
+uint8_t uart_dmarx_peek(UART_HandleTypeDef *huart, uart_rx_span_t *span) {
+    uart_rx_fifo_t *uart_rx_fifo = uart_rx_identify(huart);
+    uint8_t res = 0;
+
+    if ((span == NULL) || (uart_rx_fifo == NULL) || (huart->hdmarx == NULL)) {
+        return 1;
+    }
+
+    if (!uart_rx_fifo->zero_copy) {
+        uart_rx_fifo->read_ptr = uart_rx_fifo->head_ptr;
+        uart_rx_fifo->zero_copy = 1;
+    }
+
+    uint32_t size = huart->RxXferSize;
+    uint32_t received = uart_dmarx_received(huart, uart_rx_fifo);
+    uint32_t len = received - uart_rx_fifo->read_ptr;
+
+    if (len > size) {
+        uart_rx_fifo->read_ptr = received;
+        len = 0;
+        res = 2;
+    }
+
+    uint32_t offset = uart_rx_fifo->read_ptr % size;
+
+    span->data[0] = huart->pRxBuffPtr + offset;
+    span->len[0] = (len < size - offset) ? len : size - offset;
+    span->data[1] = huart->pRxBuffPtr;
+    span->len[1] = len - span->len[0];
+
+    return res;
+}
+
+/**
+ * @brief Release the data got by `uart_dmarx_peek`.
+ *
+ * @param huart The handle of UART
+ * @param len The length consumed, from the start of the first span.
+ * @return Consume status:
+ * @retval - 0: Success.
+ * @retval - 1: This UART is not zero-copy, or `len` is more than received.
+ * @retval - 2: The DMA has overwritten the span while it was parsed, the
+ *              result of parsing may be wrong. The data is dropped.
+ */
+uint8_t uart_dmarx_consume(UART_HandleTypeDef *huart, uint32_t len) {
+    uart_rx_fifo_t *uart_rx_fifo = uart_rx_identify(huart);
+
+    if ((uart_rx_fifo == NULL) || (!uart_rx_fifo->zero_copy)) {
+        return 1;
+    }
+
+    uint32_t received = uart_dmarx_received(huart, uart_rx_fifo);
+
+    if (received - uart_rx_fifo->read_ptr > huart->RxXferSize) {
+        uart_rx_fifo->read_ptr = received;
+        return 2;
+    }
+
+    if (len > received - uart_rx_fifo->read_ptr) {
+        return 1;
+    }
+
+    uart_rx_fifo->read_ptr += len;
+    return 0;
+}
+
 /**
  * @brief Resize the receive buf and fifo of UART.
  *
@@ -3380,73 +943,97 @@ uint32_t uart_dmarx_get_fifo_size(UART_HandleTypeDef *huart) {
  * @return The point of UART tx buffer.
  */
 static inline uart_tx_buf_t *uart_tx_identify(UART_HandleTypeDef *huart) {
-    switch ((uintptr_t)(huart->Instance)) {
+    const uart_port_t *port = uart_port_identify(huart);
+    return (port == NULL) ? NULL : port->tx_buf;
+}
 
-#if USART1_TX_DMA
-        case USART1_BASE: {
-            return &usart1_tx_buf;
-        }
-#endif /* USART1_TX_DMA */
+/**
+ * @brief Disable the interrupt to modify the send buf.
+ *
+ * @return The interrupt state to restore.
+ */
+static inline uint32_t uart_dmatx_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
 
-#if USART2_TX_DMA
-        case USART2_BASE: {
-            return &usart2_tx_buf;
-        }
-#endif /* USART2_TX_DMA */
+/**
+ * @brief Restore the interrupt state.
+ *
+ * @param primask The return of `uart_dmatx_lock`.
+ */
+static inline void uart_dmatx_unlock(uint32_t primask) {
+    __set_PRIMASK(primask);
+}
 
-#if USART3_TX_DMA
-        case USART3_BASE: {
-            return &usart3_tx_buf;
-        }
-#endif /* USART3_TX_DMA */
+/**
+ * @brief Clear the queued frames and the transfer state.
+ *
+ * @param tx_buf The send buf.
+ */
+static void uart_dmatx_reset(uart_tx_buf_t *tx_buf) {
+    tx_buf->head_ptr = 0;
+    tx_buf->back = 0;
+    tx_buf->writers = 0;
+    tx_buf->busy = 0;
+    tx_buf->pending = 0;
+}
 
-#if UART4_TX_DMA
-        case UART4_BASE: {
-            return &uart4_tx_buf;
-        }
-#endif /* UART4_TX_DMA */
+/**
+ * @brief Start to transmit the back buffer if send is requested, the DMA is
+ *        idle and no frame is being written.
+ *
+ * @param huart The handle of UART.
+ * @param tx_buf The send buf.
+ * @return The length started to transmit.
+ */
+static uint32_t uart_dmatx_kick(UART_HandleTypeDef *huart,
+                                uart_tx_buf_t *tx_buf) {
+    uint8_t *buf = NULL;
+    uint32_t len = 0;
 
-#if UART5_TX_DMA
-        case UART5_BASE: {
-            return &uart5_tx_buf;
-        }
-#endif /* UART5_TX_DMA */
+    uint32_t primask = uart_dmatx_lock();
 
-#if USART6_TX_DMA
-        case USART6_BASE: {
-            return &usart6_tx_buf;
-        }
-#endif /* USART6_TX_DMA */
+    if (tx_buf->pending && !tx_buf->busy && (tx_buf->writers == 0)) {
+        buf = tx_buf->send_buf + tx_buf->back * tx_buf->buf_size;
+        len = tx_buf->head_ptr;
 
-#if UART7_TX_DMA
-        case UART7_BASE: {
-            return &uart7_tx_buf;
-        }
-#endif /* UART7_TX_DMA */
+        /* Swap the buffers, writers continue with the other one. */
+        tx_buf->back ^= 1;
+        tx_buf->head_ptr = 0;
+        tx_buf->pending = 0;
+        tx_buf->busy = (len != 0);
+    }
 
-#if UART8_TX_DMA
-        case UART8_BASE: {
-            return &uart8_tx_buf;
-        }
-#endif /* UART8_TX_DMA */
+    uart_dmatx_unlock(primask);
 
-#if UART9_TX_DMA
-        case UART9_BASE: {
-            return &uart9_tx_buf;
-        }
-#endif /* UART9_TX_DMA */
+    if (len == 0) {
+        return 0;
+    }
 
-#if UART10_TX_DMA
-        case UART10_BASE: {
-            return &uart10_tx_buf;
-        }
-#endif /* UART10_TX_DMA */
+    if (HAL_UART_Transmit_DMA(huart, buf, (uint16_t)len) != HAL_OK) {
+        /* The frames in this buffer are lost. */
+        tx_buf->busy = 0;
+        return 0;
+    }
 
-        default: {
-        } break;
+    return len;
+}
+
+/**
+ * @brief UART DMA transmit completed callback.
+ *
+ * @param huart The handle of UART.
+ */
+static void uart_dmatx_done_callback(UART_HandleTypeDef *huart) {
+    uart_tx_buf_t *send_tx_buf = uart_tx_identify(huart);
+    if (send_tx_buf == NULL) {
+        return;
     }
 
-    return NULL;
+    send_tx_buf->busy = 0;
+    uart_dmatx_kick(huart, send_tx_buf);
 }
 
 /**
@@ -3456,6 +1043,8 @@ static inline uart_tx_buf_t *uart_tx_identify(UART_HandleTypeDef *huart) {
  * @param data The data will be write.
  * @param len The data length will be written.
  * @return The length that be written.
+ * @note Nothing is written if the remain space can not hold the data, so the
+ *       data will never be truncated.
  */
 uint32_t uart_dmatx_write(UART_HandleTypeDef *huart, const void *data,
                           size_t len) {
@@ -3463,32 +1052,130 @@ uint32_t uart_dmatx_write(UART_HandleTypeDef *huart, const void *data,
         return 0;
     }
 
+    uint8_t *dst = uart_dmatx_reserve(huart, len);
+    if (dst == NULL) {
+        return 0;
+    }
+
+    memcpy(dst, data, len);
+    return uart_dmatx_commit(huart, len);
+}
+
+/**
+ * @brief Write several segments to the buffer as one frame, without
+ *        assembling them in a temporary buffer first.
+ *
+ * @param huart The handle of UART.
+ * @param vec The segments, the segment with `len` 0 is skipped.
+ * @param count The number of segments.
+ * @return The length that be written.
+ * @note Nothing is written if the remain space can not hold all segments,
+ *       so a frame will never be truncated.
+ */
+uint32_t uart_dmatx_write_vec(UART_HandleTypeDef *huart,
+                              const uart_tx_vec_t *vec, uint32_t count) {
+    if ((vec == NULL) || (count == 0)) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if ((vec[i].data == NULL) && (vec[i].len != 0)) {
+            return 0;
+        }
+        total += vec[i].len;
+    }
+
+    uint8_t *dst = uart_dmatx_reserve(huart, total);
+    if (dst == NULL) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        memcpy(dst, vec[i].data, vec[i].len);
+        dst += vec[i].len;
+    }
+
+    return uart_dmatx_commit(huart, total);
+}
+
+/**
+ * @brief Reserve space in the buffer to build a frame in place.
+ *
+ * @param huart The handle of UART.
+ * @param len The length to reserve.
+ * @return The start address of the reserved space, `NULL` if the remain
+ *         space is not enough.
+ * @note The space is taken at once, so several tasks and interrupts can
+ *       build their frames at the same time without blocking each other.
+ *       Fill all the space and call `uart_dmatx_commit` with the same length.
+ *       The buffer is not sent until every reserved frame is committed.
+ */
+void *uart_dmatx_reserve(UART_HandleTypeDef *huart, size_t len) {
+    if (len == 0) {
+        return NULL;
+    }
+
+    uart_tx_buf_t *send_tx_buf = uart_tx_identify(huart);
+    if ((send_tx_buf == NULL) || (send_tx_buf->send_buf == NULL)) {
+        return NULL;
+    }
+
+    uint8_t *dst = NULL;
+    uint32_t primask = uart_dmatx_lock();
+
+    if ((send_tx_buf->buf_size - send_tx_buf->head_ptr >= len) &&
+        (send_tx_buf->writers < UINT8_MAX)) {
+        dst = send_tx_buf->send_buf +
+              send_tx_buf->back * send_tx_buf->buf_size +
+              send_tx_buf->head_ptr;
+        send_tx_buf->head_ptr += len;
+        ++send_tx_buf->writers;
+    }
+
+    uart_dmatx_unlock(primask);
+    return dst;
+}
+
+/**
+ * @brief Commit the frame built in the space from `uart_dmatx_reserve`.
+ *
+ * @param huart The handle of UART.
+ * @param len The reserved length.
+ * @return The length that be committed.
+ * @note If the send is requested while the frame is being written, the
+ *       buffer is sent by the last commit.
+ */
+uint32_t uart_dmatx_commit(UART_HandleTypeDef *huart, size_t len) {
     uart_tx_buf_t *send_tx_buf = uart_tx_identify(huart);
     if (send_tx_buf == NULL) {
         return 0;
     }
 
-    /* Get the remain length of buffer. */
-    uint32_t buf_remain = send_tx_buf->buf_size - send_tx_buf->head_ptr;
+    uint32_t primask = uart_dmatx_lock();
 
-    /* Prevent overflow. */
-    if (buf_remain < len) {
-        memcpy(send_tx_buf->send_buf + send_tx_buf->head_ptr, data, buf_remain);
-        send_tx_buf->head_ptr += buf_remain;
-        return buf_remain;
+    if (send_tx_buf->writers == 0) {
+        /* Nothing is reserved. */
+        len = 0;
     } else {
-        memcpy(send_tx_buf->send_buf + send_tx_buf->head_ptr, data, len);
-        send_tx_buf->head_ptr += len;
-        return len;
+        --send_tx_buf->writers;
     }
+
+    uart_dmatx_unlock(primask);
+
+    uart_dmatx_kick(huart, send_tx_buf);
+    return len;
 }
 
 /**
  * @brief Transmit the data in the buf.
  *
  * @param huart The handle of UART.
- * @return The length which is succeed transmitted.
+ * @return The length started to transmit. 0 if the DMA is busy, the queued
+ *         frames are sent by the Tx complete callback automatically.
  * @note If you want transmit data, using `uart_dmatx_write` before.
+ *       Never waits for the last transfer, but the UART interrupt must be
+ *       enabled to get the Tx complete callback.
  *       If you have huge continous data to transmit, we recommand use
  *       `HAL_UART_Transmit_DMA()`.
  */
@@ -3502,25 +1189,18 @@ uint32_t uart_dmatx_send(UART_HandleTypeDef *huart) {
         return 0;
     }
 
-    uint32_t len = send_tx_buf->head_ptr;
-    if (len == 0) {
-        return 0;
-    }
-
-    /* Wait for last transfer end. */
-    while (__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) == RESET)
-        ;
+    uint32_t primask = uart_dmatx_lock();
+    send_tx_buf->pending = (send_tx_buf->head_ptr != 0);
+    uart_dmatx_unlock(primask);
 
-    HAL_UART_Transmit_DMA(huart, send_tx_buf->send_buf, (uint16_t)len);
-    send_tx_buf->head_ptr = 0;
-    return len;
+    return uart_dmatx_kick(huart, send_tx_buf);
 }
 
 /**
  * @brief Resize the send buf of UART.
  *
  * @param huart The handle of UART
- * @param size New size
+ * @param size New size of each buffer, two buffers are allocated.
  * @return Resize message:
  * @retval - 0: Success
  * @retval - 1: This uart not enable DMA Tx.
@@ -3538,9 +1218,9 @@ uint8_t uart_dmatx_resize_buf(UART_HandleTypeDef *huart, uint32_t size) {
         return 1;
     }
 
-    if ((huart->gState) & (HAL_UART_STATE_BUSY_TX | HAL_UART_STATE_BUSY) &
-        ~HAL_UART_STATE_READY) {
-        /* The UART is busy. */
+    if (send_tx_buf->busy || (send_tx_buf->head_ptr != 0) ||
+        (send_tx_buf->writers != 0)) {
+        /* The UART is busy or frames are queued. */
         return 3;
     }
 
@@ -3550,7 +1230,7 @@ uint8_t uart_dmatx_resize_buf(UART_HandleTypeDef *huart, uint32_t size) {
         return 0;
     }
 
-    uint8_t *new_ptr = CSP_REALLOC(send_tx_buf->send_buf, size);
+    uint8_t *new_ptr = CSP_REALLOC(send_tx_buf->send_buf, size * 2);
 
     if (new_ptr == NULL) {
         return 2;
@@ -3558,6 +1238,7 @@ uint8_t uart_dmatx_resize_buf(UART_HandleTypeDef *huart, uint32_t size) {
 
     send_tx_buf->send_buf = new_ptr;
     send_tx_buf->buf_size = size;
+    uart_dmatx_reset(send_tx_buf);
 
     return 0;
 }
@@ -3566,7 +1247,7 @@ uint8_t uart_dmatx_resize_buf(UART_HandleTypeDef *huart, uint32_t size) {
  * @brief Get the buffer size of UART DMA Tx.
  *
  * @param huart The handle of UART.
- * @return The size of UART DMA Tx buf.
+ * @return The size of one UART DMA Tx buf.
  */
 uint32_t uart_damtx_get_buf_szie(UART_HandleTypeDef *huart) {
     uart_tx_buf_t *uart_tx_buf = uart_tx_identify(huart);
@@ -3665,6 +1346,17 @@ void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart) {
     }
 }
 
+/**
+ * @brief Tx Transfer completed callbacks.
+ *
+ * @param huart The handle of UART.
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart->hdmatx != NULL) {
+        uart_dmatx_done_callback(huart);
+    }
+}
+
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS == 0 */
 
 /**
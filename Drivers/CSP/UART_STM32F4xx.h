@@ -758,6 +758,32 @@ uint8_t uart10_deinit(void);
 
 /* clang-format on */
 
+/*****************************************************************************
+ * @defgroup Public uart types.
+ * @{
+ */
+
+/**
+ * @brief One segment of the scatter-gather transmit.
+ */
+typedef struct {
+    const void *data; /*!< Segment data.   */
+    size_t len;       /*!< Segment length. */
+} uart_tx_vec_t;
+
+/**
+ * @brief Received data in the DMA receive buffer, the second span is used
+ *        when the data wraps around the end of the buffer.
+ */
+typedef struct {
+    const uint8_t *data[2]; /*!< Span data.                   */
+    uint32_t len[2];        /*!< Span length, 0 if not used.  */
+} uart_rx_span_t;
+
+/**
+ * @}
+ */
+
 /*****************************************************************************
  * @defgroup Public uart function.
  * @{
@@ -771,9 +797,16 @@ uint8_t uart_dmarx_resize_fifo(UART_HandleTypeDef *huart, uint32_t buf_size,
                                uint32_t fifo_size);
 uint32_t uart_dmarx_get_buf_size(UART_HandleTypeDef *huart);
 uint32_t uart_dmarx_get_fifo_size(UART_HandleTypeDef *huart);
+void uart_dmarx_rx_event_callback(UART_HandleTypeDef *huart);
+uint8_t uart_dmarx_peek(UART_HandleTypeDef *huart, uart_rx_span_t *span);
+uint8_t uart_dmarx_consume(UART_HandleTypeDef *huart, uint32_t len);
 
 uint32_t uart_dmatx_write(UART_HandleTypeDef *huart, const void *data,
                           size_t len);
+uint32_t uart_dmatx_write_vec(UART_HandleTypeDef *huart,
+                              const uart_tx_vec_t *vec, uint32_t count);
+void *uart_dmatx_reserve(UART_HandleTypeDef *huart, size_t len);
+uint32_t uart_dmatx_commit(UART_HandleTypeDef *huart, size_t len);
 uint32_t uart_dmatx_send(UART_HandleTypeDef *huart);
 uint8_t uart_dmatx_resize_buf(UART_HandleTypeDef *huart, uint32_t size);
 uint32_t uart_damtx_get_buf_szie(UART_HandleTypeDef *huart);
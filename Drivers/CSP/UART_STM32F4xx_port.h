@@ -0,0 +1,231 @@
+/**
+ * @file    UART_STM32F4xx_port.h
+ * @author  Deadline039
+ * @brief   Instance template of UART on STM32F4xx
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    Only included by `UART_STM32F4xx.c`, once for each enabled UART,
+ *          so there is no include guard. Define these before including:
+ *           - `UART_PORT_INSTANCE`: The instance, such as `USART1`.
+ *           - `UART_PORT_PREFIX`: The prefix of the configuration, such as
+ *             `USART1_`. The instance itself is a macro and can not be
+ *             pasted.
+ *           - `UART_PORT_name`: The lower case name, such as `usart1`.
+ *          It defines the handles, buffers, `xxx_init`, `xxx_deinit` and the
+ *          ISRs of the instance, the work is done by `uart_port_xxx`.
+ *          The pins not defined by the configuration (such as CTS and RTS of
+ *          UART7) are not used.
+ */
+
+/* Configuration of this instance, such as `UART_CFG(TX)` -> `USART1_TX`. */
+#define UART_CFG(x)        UART_CFG_(UART_PORT_PREFIX, x)
+#define UART_CFG_(p, x)    UART_CFG__(p, x)
+#define UART_CFG__(p, x)   p##x
+
+/* Symbol of this instance, such as `UART_SYM(handle)` -> `usart1_handle`. */
+#define UART_SYM(x)        UART_SYM_(UART_PORT_name, x)
+#define UART_SYM_(n, x)    UART_SYM__(n, x)
+#define UART_SYM__(n, x)   n##_##x
+
+/* Clock of this instance, such as `__HAL_RCC_USART1_CLK_ENABLE()`. */
+#define UART_RCC(op)       UART_RCC_(UART_PORT_PREFIX, op)
+#define UART_RCC_(p, op)   UART_RCC__(p, op)
+#define UART_RCC__(p, op)  __HAL_RCC_##p##CLK_##op()
+
+UART_HandleTypeDef UART_SYM(handle) = {
+    .Instance = UART_PORT_INSTANCE,
+    .Init = {.WordLength = UART_WORDLENGTH_8B,
+             .StopBits = UART_STOPBITS_1,
+             .Parity = UART_PARITY_NONE}};
+
+#if UART_CFG(RX_DMA)
+
+static DMA_HandleTypeDef UART_SYM(dmarx_handle) = {
+    .Instance =
+        CSP_DMA_STREAM(UART_CFG(RX_DMA_NUMBER), UART_CFG(RX_DMA_STREAM)),
+    .Init = {.Channel = CSP_DMA_CHANNEL(UART_CFG(RX_DMA_CHANNEL)),
+             .Direction = DMA_PERIPH_TO_MEMORY,
+             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
+             .MemInc = DMA_MINC_ENABLE,
+             .Mode = DMA_CIRCULAR,
+             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
+             .PeriphInc = DMA_PINC_DISABLE,
+             .Priority = CSP_DMA_PRIORITY(UART_CFG(RX_DMA_PRIORITY))}};
+
+static uart_rx_fifo_t UART_SYM(rx_fifo) = {
+    .buf_size = UART_CFG(RX_DMA_BUF_SIZE),
+    .fifo_size = UART_CFG(RX_DMA_FIFO_SIZE)};
+
+#endif /* UART_CFG(RX_DMA) */
+
+#if UART_CFG(TX_DMA)
+
+static DMA_HandleTypeDef UART_SYM(dmatx_handle) = {
+    .Instance =
+        CSP_DMA_STREAM(UART_CFG(TX_DMA_NUMBER), UART_CFG(TX_DMA_STREAM)),
+    .Init = {.Channel = CSP_DMA_CHANNEL(UART_CFG(TX_DMA_CHANNEL)),
+             .Direction = DMA_MEMORY_TO_PERIPH,
+             .MemDataAlignment = DMA_MDATAALIGN_BYTE,
+             .MemInc = DMA_MINC_ENABLE,
+             .Mode = DMA_NORMAL,
+             .PeriphDataAlignment = DMA_PDATAALIGN_BYTE,
+             .PeriphInc = DMA_PINC_DISABLE,
+             .Priority = CSP_DMA_PRIORITY(UART_CFG(TX_DMA_PRIORITY))}};
+
+static uart_tx_buf_t UART_SYM(tx_buf) = {
+    .buf_size = UART_CFG(TX_DMA_BUF_SIZE)};
+
+#endif /* UART_CFG(TX_DMA) */
+
+/**
+ * @brief Enable the clock of UART, GPIO and DMA.
+ *
+ */
+static void UART_SYM(clk_enable)(void) {
+#if UART_CFG(TX)
+    CSP_GPIO_CLK_ENABLE(UART_CFG(TX_PORT));
+#endif /* UART_CFG(TX) */
+
+#if UART_CFG(RX)
+    CSP_GPIO_CLK_ENABLE(UART_CFG(RX_PORT));
+#endif /* UART_CFG(RX) */
+
+#if UART_CFG(CTS)
+    CSP_GPIO_CLK_ENABLE(UART_CFG(CTS_PORT));
+#endif /* UART_CFG(CTS) */
+
+#if UART_CFG(RTS)
+    CSP_GPIO_CLK_ENABLE(UART_CFG(RTS_PORT));
+#endif /* UART_CFG(RTS) */
+
+    UART_RCC(ENABLE);
+
+#if UART_CFG(RX_DMA)
+    CSP_DMA_CLK_ENABLE(UART_CFG(RX_DMA_NUMBER));
+#endif /* UART_CFG(RX_DMA) */
+
+#if UART_CFG(TX_DMA)
+    CSP_DMA_CLK_ENABLE(UART_CFG(TX_DMA_NUMBER));
+#endif /* UART_CFG(TX_DMA) */
+}
+
+/**
+ * @brief Disable the clock of UART.
+ *
+ */
+static void UART_SYM(clk_disable)(void) {
+    UART_RCC(DISABLE);
+}
+
+static const uart_port_t UART_SYM(port) = {
+    .huart = &UART_SYM(handle),
+    .clk_enable = UART_SYM(clk_enable),
+    .clk_disable = UART_SYM(clk_disable),
+
+#if UART_CFG(TX)
+    .tx = {CSP_GPIO_PORT(UART_CFG(TX_PORT)), UART_CFG(TX_PIN),
+           UART_CFG(TX_AF)},
+#endif /* UART_CFG(TX) */
+
+#if UART_CFG(RX)
+    .rx = {CSP_GPIO_PORT(UART_CFG(RX_PORT)), UART_CFG(RX_PIN),
+           UART_CFG(RX_AF)},
+#endif /* UART_CFG(RX) */
+
+#if UART_CFG(CTS)
+    .cts = {CSP_GPIO_PORT(UART_CFG(CTS_PORT)), UART_CFG(CTS_PIN),
+            UART_CFG(CTS_AF)},
+#endif /* UART_CFG(CTS) */
+
+#if UART_CFG(RTS)
+    .rts = {CSP_GPIO_PORT(UART_CFG(RTS_PORT)), UART_CFG(RTS_PIN),
+            UART_CFG(RTS_AF)},
+#endif /* UART_CFG(RTS) */
+
+#if UART_CFG(IT_ENABLE)
+    .irq = {UART_CFG(IRQn), UART_CFG(IT_PRIORITY), UART_CFG(IT_SUB), true},
+#endif /* UART_CFG(IT_ENABLE) */
+
+#if UART_CFG(RX_DMA)
+    .dmarx = &UART_SYM(dmarx_handle),
+    .dmarx_irq = {UART_CFG(RX_DMA_IRQn), UART_CFG(RX_DMA_IT_PRIORITY),
+                  UART_CFG(RX_DMA_IT_SUB), true},
+    .rx_fifo = &UART_SYM(rx_fifo),
+#endif /* UART_CFG(RX_DMA) */
+
+#if UART_CFG(TX_DMA)
+    .dmatx = &UART_SYM(dmatx_handle),
+    .dmatx_irq = {UART_CFG(TX_DMA_IRQn), UART_CFG(TX_DMA_IT_PRIORITY),
+                  UART_CFG(TX_DMA_IT_SUB), true},
+    .tx_buf = &UART_SYM(tx_buf),
+#endif /* UART_CFG(TX_DMA) */
+};
+
+/**
+ * @brief UART initialization
+ *
+ * @param baud_rate Baud rate.
+ * @return UART init status, see `uart_port_init`.
+ */
+uint8_t UART_SYM(init)(uint32_t baud_rate) {
+    return uart_port_init(&UART_SYM(port), baud_rate);
+}
+
+/**
+ * @brief UART deinitialization.
+ *
+ * @return UART deinit status, see `uart_port_deinit`.
+ */
+uint8_t UART_SYM(deinit)(void) {
+    return uart_port_deinit(&UART_SYM(port));
+}
+
+#if UART_CFG(IT_ENABLE)
+
+/**
+ * @brief UART ISR
+ *
+ */
+void UART_CFG(IRQHandler)(void) {
+    uart_port_irq_handler(&UART_SYM(port));
+}
+
+#endif /* UART_CFG(IT_ENABLE) */
+
+#if UART_CFG(RX_DMA)
+
+/**
+ * @brief UART Rx DMA ISR
+ *
+ */
+void UART_CFG(RX_DMA_IRQHandler)(void) {
+    HAL_DMA_IRQHandler(&UART_SYM(dmarx_handle));
+}
+
+#endif /* UART_CFG(RX_DMA) */
+
+#if UART_CFG(TX_DMA)
+
+/**
+ * @brief UART Tx DMA ISR
+ *
+ */
+void UART_CFG(TX_DMA_IRQHandler)(void) {
+    HAL_DMA_IRQHandler(&UART_SYM(dmatx_handle));
+}
+
+#endif /* UART_CFG(TX_DMA) */
+
+#undef UART_CFG
+#undef UART_CFG_
+#undef UART_CFG__
+#undef UART_SYM
+#undef UART_SYM_
+#undef UART_SYM__
+#undef UART_RCC
+#undef UART_RCC_
+#undef UART_RCC__
+
+#undef UART_PORT_INSTANCE
+#undef UART_PORT_PREFIX
+#undef UART_PORT_name
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Decode the telemetry stream (see User/Application/Inc/telemetry.h) to CSV.
+
+Usage:
+    telemetry_decode.py capture.bin > out.csv
+    telemetry_decode.py --serial COM3 --baud 115200 > out.csv   (needs pyserial)
+
+Only v2 frames of MSG_TELEMETRY are decoded, other bytes on the port (v1
+frames, printf output) are skipped.
+"""
+
+import argparse
+import struct
+import sys
+
+MSG_TELEMETRY = 0x02
+MSG_DATA_INT32 = 0x04
+MSG_DATA_STRING = 0x0A
+
+SYNC = b"\xa5\x5a"
+HEAD_LENGTH = 6
+CRC_LENGTH = 4
+MAX_DATA_LENGTH = 250
+FORMAT_VERSION = 1
+
+
+def crc32_stm32(data):
+    """CRC-32 of the STM32 CRC unit, little-endian words fed MSB first."""
+    crc = 0xFFFFFFFF
+    words = len(data) & ~3
+    order = [data[i + j] for i in range(0, words, 4) for j in (3, 2, 1, 0)]
+    for byte in order + list(data[words:]):
+        crc ^= byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else crc << 1
+            crc &= 0xFFFFFFFF
+    return crc
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    # ZigZag
+    return (value >> 1) ^ -(value & 1), pos
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.buf = bytearray()
+        self.names = None
+        self.scales = None
+        self.crc_errors = 0
+        self.lost_frames = 0
+        self.last_seq = None
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                del self.buf[:-1]
+                return
+            del self.buf[:start]
+            if len(self.buf) < HEAD_LENGTH:
+                return
+            length = self.buf[2]
+            if length > MAX_DATA_LENGTH:
+                del self.buf[:1]
+                continue
+            total = HEAD_LENGTH + length + CRC_LENGTH
+            if len(self.buf) < total:
+                return
+            frame = bytes(self.buf[:total])
+            crc = struct.unpack_from("<I", frame, total - CRC_LENGTH)[0]
+            if crc32_stm32(frame[:total - CRC_LENGTH]) != crc:
+                self.crc_errors += 1
+                del self.buf[:1]
+                continue
+            del self.buf[:total]
+            self.frame(frame[3], frame[4], frame[5], frame[HEAD_LENGTH:-4])
+
+    def frame(self, mean, type_, seq, data):
+        if mean != MSG_TELEMETRY:
+            return
+        if self.last_seq is not None:
+            self.lost_frames += (seq - self.last_seq - 1) & 0xFF
+        self.last_seq = seq
+
+        if data[0] != FORMAT_VERSION:
+            return
+        if type_ == MSG_DATA_STRING:
+            self.descriptor(data)
+        elif type_ == MSG_DATA_INT32 and self.names is not None:
+            self.data(data)
+
+    def descriptor(self, data):
+        count = data[1]
+        pos = 2
+        names, scales = [], []
+        for _ in range(count):
+            end = data.index(0, pos)
+            names.append(data[pos:end].decode("ascii", "replace"))
+            scales.append(struct.unpack_from("<f", data, end + 1)[0])
+            pos = end + 5
+        if names != self.names:
+            self.out.write("index," + ",".join(names) + "\n")
+        self.names, self.scales = names, scales
+
+    def data(self, data):
+        count = data[1]
+        if count != len(self.names):
+            return
+        index, samples = struct.unpack_from("<HB", data, 2)
+        pos = 5
+        values = [0] * count
+        for i in range(samples):
+            for ch in range(count):
+                delta, pos = read_varint(data, pos)
+                values[ch] = (values[ch] + delta + 2**31) % 2**32 - 2**31
+            row = [str((index + i) & 0xFFFF)]
+            row += ["%g" % (v / s) for v, s in zip(values, self.scales)]
+            self.out.write(",".join(row) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file", nargs="?", help="captured raw bytes")
+    parser.add_argument("--serial", help="serial port to read from")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    decoder = Decoder(sys.stdout)
+    try:
+        if args.serial:
+            import serial
+
+            with serial.Serial(args.serial, args.baud, timeout=0.1) as port:
+                while True:
+                    decoder.feed(port.read(4096))
+                    sys.stdout.flush()
+        elif args.file:
+            with open(args.file, "rb") as f:
+                decoder.feed(f.read())
+        else:
+            decoder.feed(sys.stdin.buffer.read())
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write("crc errors: %d, lost frames: %d\n" %
+                     (decoder.crc_errors, decoder.lost_frames))
+
+
+if __name__ == "__main__":
+    main()
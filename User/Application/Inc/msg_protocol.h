@@ -2,7 +2,7 @@
  * @file    msg_protocol.h
  * @author  Deadline039
  * @brief   消息协议
- * @version 1.0
+ * @version 1.5
  * @date    2024-03-01
  * @note    接收暂只支持DMA, 如果使用中断自行到`uart.h`编写相应代码
  *
@@ -19,6 +19,15 @@
 *      (##) `message_send_data`函数需要指定`data_mean`(也就是`message_mean_t`
 *           枚举中的类型), `data_type`(数据类型, 整数, 浮点或者字符串等),
 *           `data`(数据指针, 也就是要发送的数据), 以及`data_len`, 数据长度
+*      (##) 使用 DMA 发送的串口也可以调用`message_send_begin`取得发送缓冲区中
+*           的数据区, 原地填写数据后调用`message_send_end`发送, 省去一次复制
+*      (##) 需要传输较长的数据时调用`message_send_data_v2`发送 v2 帧, 最长
+*           `MSG_V2_MAX_DATA_LENGTH`字节, 带序号与 CRC-32 校验
+* (#) v2 帧格式
+*      [0xA5][0x5A][长度][数据含义][数据类型][序号][数据...][CRC, 4 字节小端]
+*      CRC-32 (与 STM32 CRC 单元一致, 见`crc.h`), 从长度字节算到数据末尾,
+*      由 CRC 单元计算. 序号每种数据含义独立累加, 接收端据此统计丢帧.
+*      v1 与 v2 帧可以在同一串口混发, 使用同一个回调函数
 * (#) 接收
 *      (##) 调用`message_add_polling_handle`添加要轮询的串口
 *      (##) 调用`message_register_recv_callback`注册接收回调函数, 当收到消息
@@ -28,13 +37,27 @@
 *      (##) 回调函数参数形式必须是void (uint8_t, message_type_t, void*)
 *           第一个参数是消息长度, 第二个参数是数据类型(整数, 浮点或者字符串等),
 *           第三个参数是数据区内容, 无返回值
+*      (##) 使用 RTOS 时可以调用`message_wait_data`代替轮询, 任务阻塞到串口
+*           收到数据, 然后处理所有串口. 串口中断与 DMA 接收中断优先级不能高于
+*           `configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY`
 *      (##) `message_polling_data`仅支持DMA接收, 如果是串口接收需要自行编写回调
 *           函数与接收逻辑
+*      (##) 接收按字节流解析, 多帧连在一起或者一帧分多次到达都可以处理.
+*           调用`message_get_port_stats`查看每个串口的帧数与错误计数
+*      (##) 直接解析串口 DMA 接收缓冲区 (`uart_dmarx_peek`), 轮询的串口不
+*           能再用`uart_dmarx_read`读取. DMA 接收缓冲区要能容纳两次处理
+*           之间收到的数据, 否则计入`rx_overruns`
 *      (##) 调用`message_remove_polling_handle`删除要轮询的串口
 ******************************************************************************
 *    Date    | Version |   Author    | Version Info
 * -----------+---------+-------------+----------------------------------------
 * 2024-04-13 |   1.0   | Deadline039 | 初版
+* 2026-10-18 |   1.1   | Deadline039 | 发送不再分配内存, 添加原地组帧发送
+* 2026-10-18 |   1.2   | Deadline039 | 接收改为流式解析, 添加接收统计
+* 2026-10-18 |   1.3   | Deadline039 | 添加接收事件通知 (message_wait_data)
+* 2026-10-18 |   1.4   | Deadline039 | 添加 v2 帧 (长数据, 序号, CRC-16)
+* 2026-10-18 |   1.5   | Deadline039 | v2 帧改用 CRC-32, 由 CRC 单元计算
+* 2026-10-18 |   1.6   | Deadline039 | 直接解析 DMA 接收缓冲区, 不再复制
 */
 
 #ifndef __MSG_PROTOCOL_H
@@ -46,16 +69,31 @@
 /* 如果是数组, 可以调用此宏定义获取长度; 堆分配的内存勿用!! */
 #define MSG_GET_DATA_ARRAY_LENGTH(X) (sizeof(X))
 
+/* v2 帧最大数据长度 */
+#define MSG_V2_MAX_DATA_LENGTH       250
+#define MSG_V2_SYNC0                 0xA5 /* v2 帧同步字第一个字节 */
+#define MSG_V2_SYNC1                 0x5A /* v2 帧同步字第二个字节 */
+#define MSG_V2_HEAD_LENGTH           6    /* v2 帧头长度 */
+#define MSG_V2_CRC_LENGTH            4    /* v2 帧校验长度 */
+
+/* 串口收到数据时通知接收任务 (`message_wait_data`), 需要 FreeRTOS */
+#define MSG_RX_NOTIFY                1
+
 #if (MSG_MAX_DATA_LENGTH <= 1)
 #error Max data length must be more than 1.
 #elif (MSG_MAX_DATA_LENGTH >= 250)
 #error Max data length must be less than 250.
 #endif /* MSG_MAX_DATA_LENGTH */
 
+#if (MSG_V2_MAX_DATA_LENGTH < 1 || MSG_V2_MAX_DATA_LENGTH > 250)
+#error V2 max data length must be in 1~250.
+#endif /* MSG_V2_MAX_DATA_LENGTH */
+
 #define MSG_NO_DATA           0x00 /* 没有收到消息 */
 #define MSG_DATA_OVER         0xFF /* 数据长度溢出 */
-#define MSG_DATA_LENGTH_ERROR 0xFE /* 实际接收长度与消息中的长度不一 */
+#define MSG_DATA_LENGTH_ERROR 0xFE /* 实际接收长度与消息中的长度不一 (已不再使用) */
 #define MSG_DATA_VERIFY_ERROR 0xFD /* 接收校验错误(最后一个字节不是0xFF) */
+#define MSG_DATA_CRC_ERROR    0xFC /* v2 帧 CRC 校验错误 */
 
 /**
  * @brief 数据含义
@@ -63,6 +101,7 @@
 typedef enum {
     MSG_REMOTE = 0x00U, /*!< 遥控器通信数据 遥控器->主板 */
     MSG_CHASSIS,        /*!< 主板底盘通信   底盘<->主板 */
+    MSG_TELEMETRY,      /*!< 遥测数据       主板->上位机 */
 
     // MSG_DT35,               /*接收DT35信息*/
     MSG_MEAN_LENGTH_RESERVE /*!< 保留位, 用于定义数据长度 */
@@ -86,6 +125,20 @@ typedef enum {
     MSG_DATA_STRING
 } message_type_t;
 
+/**
+ * @brief 串口接收统计信息
+ */
+typedef struct {
+    uint32_t rx_bytes;      /*!< 收到的字节数 */
+    uint32_t frames;        /*!< 解析出的完整帧数 */
+    uint32_t over_errors;   /*!< 长度溢出次数 */
+    uint32_t verify_errors; /*!< 帧尾校验错误次数 */
+    uint32_t crc_errors;    /*!< v2 帧 CRC 错误次数 */
+    uint32_t lost_frames;   /*!< 按 v2 帧序号推算的丢帧数 */
+    uint32_t dropped_bytes; /*!< 重新同步时丢弃的字节数 */
+    uint32_t rx_overruns;   /*!< DMA 覆盖了未解析数据的次数 */
+} message_port_stats_t;
+
 /**
  * @brief 回调函数指针定义
  *
@@ -103,10 +156,20 @@ void message_register_send_handle(message_mean_t msg_mean,
                                   UART_HandleTypeDef *msg_send_handle);
 void message_send_data(message_mean_t data_mean, message_type_t data_type,
                        void *data, size_t data_len);
+void *message_send_begin(message_mean_t data_mean, message_type_t data_type,
+                         size_t data_len);
+void message_send_end(message_mean_t data_mean, size_t data_len);
+void message_send_data_v2(message_mean_t data_mean, message_type_t data_type,
+                          const void *data, size_t data_len);
 
 void message_add_polling_handle(UART_HandleTypeDef *uart_handle);
 void message_remove_polling_handle(UART_HandleTypeDef *uart_handle);
 
 uint8_t message_polling_data(void);
+#if MSG_RX_NOTIFY
+uint8_t message_wait_data(uint32_t timeout);
+#endif /* MSG_RX_NOTIFY */
+uint8_t message_get_port_stats(UART_HandleTypeDef *uart_handle,
+                               message_port_stats_t *stats);
 
 #endif /* __MSG_PROTOCOL_H */
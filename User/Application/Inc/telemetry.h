@@ -0,0 +1,75 @@
+/**
+ * @file    telemetry.h
+ * @author  Deadline039
+ * @brief   遥测数据流, 每个控制周期采样一次, 差分编码后经串口发送
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    数据经`message_send_data_v2`以`MSG_TELEMETRY`发送, 使用 v2 帧的
+ *          同步字, 序号与 CRC. 上位机用`Tools/telemetry_decode.py`转成 CSV.
+ *
+ *****************************************************************************
+*                             ##### 如何使用 ####
+* (#) 调用`message_register_send_handle(MSG_TELEMETRY, ...)`注册发送串口,
+*     串口需要使能 DMA 发送
+* (#) 调用`telemetry_add_channel`添加通道, 必须在第一次采样之前添加完
+* (#) 控制任务每个周期调用一次`telemetry_sample`. 只做编码, 不发送, 不阻塞
+* (#) 在一个低优先级任务中循环调用`telemetry_wait_flush`, 写满的帧在这里发送.
+*     采样写满一帧时另一帧还没有发送完, 则丢弃刚写满的帧并计入`overruns`
+*
+* (#) 数据帧 (数据类型`MSG_DATA_INT32`)
+*      [格式版本][通道数][第一个采样的序号, 2 字节小端][采样数][采样...]
+*      每个采样依次是各通道的值, 整数化后与上一采样做差, ZigZag 编码后按
+*      LEB128 变长存放 (1~5 字节). 每帧第一个采样与 0 做差, 即绝对值,
+*      丢帧不影响之后的帧.
+* (#) 描述帧 (数据类型`MSG_DATA_STRING`)
+*      [格式版本][通道数][通道名, 以 0 结尾][缩放系数, float 小端]...
+*      第一帧以及之后每`TELEMETRY_DESC_PERIOD`个数据帧发送一次.
+*      浮点通道按`round(值 * 缩放系数)`整数化, 整数通道缩放系数为 1.
+*/
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "msg_protocol.h"
+
+#define TELEMETRY_MAX_CHANNELS   16 /* 最大通道数 */
+#define TELEMETRY_NAME_LENGTH    10 /* 通道名最大长度, 不含结尾的 0 */
+#define TELEMETRY_FRAME_SAMPLES  20 /* 每帧最多采样数, 决定上位机看到的延迟 */
+#define TELEMETRY_DESC_PERIOD    50 /* 每多少个数据帧发送一次描述帧 */
+#define TELEMETRY_FORMAT_VERSION 1  /* 帧格式版本 */
+
+#if (TELEMETRY_MAX_CHANNELS * (TELEMETRY_NAME_LENGTH + 5) + 2 >               \
+     MSG_V2_MAX_DATA_LENGTH)
+#error Telemetry descriptor frame is longer than the v2 frame.
+#endif /* TELEMETRY_MAX_CHANNELS */
+
+#if (TELEMETRY_MAX_CHANNELS * 5 + 5 > MSG_V2_MAX_DATA_LENGTH)
+#error Telemetry sample is longer than the v2 frame.
+#endif /* TELEMETRY_MAX_CHANNELS */
+
+/**
+ * @brief 通道数据类型
+ */
+typedef enum {
+    TELEMETRY_FLOAT = 0x00U, /*!< float, 按缩放系数整数化 */
+    TELEMETRY_INT16,         /*!< int16_t */
+    TELEMETRY_UINT16,        /*!< uint16_t */
+    TELEMETRY_INT32          /*!< int32_t */
+} telemetry_type_t;
+
+/**
+ * @brief 遥测统计信息
+ */
+typedef struct {
+    uint32_t samples;  /*!< 采样次数 */
+    uint32_t frames;   /*!< 发送的数据帧数 */
+    uint32_t overruns; /*!< 来不及发送而丢弃的数据帧数 */
+} telemetry_stats_t;
+
+uint8_t telemetry_add_channel(const char *name, const void *source,
+                              telemetry_type_t type, float scale);
+void telemetry_sample(void);
+uint8_t telemetry_wait_flush(uint32_t timeout);
+void telemetry_get_stats(telemetry_stats_t *stats);
+
+#endif /* __TELEMETRY_H */
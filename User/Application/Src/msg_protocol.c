@@ -2,12 +2,14 @@
  * @file    msg_protocol.c
  * @author  Deadline039
  * @brief   消息协议以及收发
- * @version 1.0
+ * @version 1.5
  * @date    2024-03-01
  * @note    接收暂只支持DMA, 如果使用中断自行到`uart.h`编写相应代码
  */
 
 #include "msg_protocol.h"
+#include "buffer_schema.h"
+#include "crc.h"
 #include "string.h"
 
 
@@ -15,6 +17,11 @@
 #include "FreeRTOS.h"
 #endif /* SYS_SUPPORT_OS */
 
+#if MSG_RX_NOTIFY
+#include "FreeRTOS.h"
+#include "task.h"
+#endif /* MSG_RX_NOTIFY */
+
 /**
  * @brief 回调函数指针
  */
@@ -25,6 +32,18 @@ static msg_recv_callback_t p_receive_callback[MSG_MEAN_LENGTH_RESERVE] = {NULL};
  */
 static UART_HandleTypeDef *p_send_handle[MSG_MEAN_LENGTH_RESERVE] = {NULL};
 
+/**
+ * @brief v2 帧发送序号, 每种数据含义一个
+ */
+static uint8_t send_sequence[MSG_MEAN_LENGTH_RESERVE] = {0};
+
+#if MSG_RX_NOTIFY
+/**
+ * @brief 等待接收事件的任务
+ */
+static TaskHandle_t volatile msg_wait_task = NULL;
+#endif /* MSG_RX_NOTIFY */
+
 /**
  * @brief 注册接收回调函数指针
  *
@@ -55,6 +74,8 @@ void message_register_send_handle(message_mean_t msg_mean,
  * @param data_type 数据类型
  * @param data 数据内容
  * @param data_len 数据长度(字节数), 使用`MSG_GET_DATA_ARRAY_LENGTH`宏获取即可
+ * @note 帧头, 数据与帧尾直接写入串口 DMA 发送缓冲区, 不分配内存.
+ *       发送缓冲区剩余空间不足时丢弃整帧, 不会发出被截断的帧
  */
 void message_send_data(message_mean_t data_mean, message_type_t data_type,
                     void *data, size_t data_len) {
@@ -67,41 +88,166 @@ void message_send_data(message_mean_t data_mean, message_type_t data_type,
     if (p_send_handle[data_mean] == NULL) {
         return;
     }
-#if SYS_SUPPORT_OS
-    uint8_t *data_buf =
-        (uint8_t *)pvPortMalloc(data_len + 3); /* 发送数据的字节流 */
-#else                                          /* SYS_SUPPORT_OS */
-    uint8_t *data_buf = (uint8_t *)malloc(data_len + 3); /* 发送数据的字节流 */
-#endif                                         /* SYS_SUPPORT_OS */
-
-    /* 复制数据到字节流, 前面空出两个字节用来标记数据 */
-    memcpy((data_buf + 2), data, data_len);
-    /* 第一个字节, 高四位标记含义, 低四位标记数据类型 */
-    *data_buf = (uint8_t)(data_mean << 4) | data_type;
-    /* 第二个字节, 标记数据长度 */
-    *(data_buf + 1) = (uint8_t)data_len;
+
+    UART_HandleTypeDef *huart = p_send_handle[data_mean];
+
+    /* 第一个字节, 高四位标记含义, 低四位标记数据类型; 第二个字节, 标记数据长度 */
+    uint8_t head[2] = {(uint8_t)(data_mean << 4) | data_type,
+                       (uint8_t)data_len};
     /* 最后一个字节, 标记数据末尾 */
-    *(data_buf + data_len + 2) = 0xFF;
+    uint8_t tail = 0xFF;
+
+    if (huart->hdmatx != NULL) {
+        const uart_tx_vec_t frame[3] = {
+            {head, sizeof(head)}, {data, data_len}, {&tail, sizeof(tail)}};
 
-    if (p_send_handle[data_mean]->hdmatx != NULL) {
-        uart_dmatx_write(p_send_handle[data_mean], data_buf, data_len + 3);
-        uart_dmatx_send(p_send_handle[data_mean]);
+        if (uart_dmatx_write_vec(huart, frame, 3) != 0) {
+            uart_dmatx_send(huart);
+        }
     } else {
-        HAL_UART_Transmit(p_send_handle[data_mean], data_buf, data_len + 3,
-                        0xFFFF);
+        HAL_UART_Transmit(huart, head, sizeof(head), 0xFFFF);
+        HAL_UART_Transmit(huart, (uint8_t *)data, data_len, 0xFFFF);
+        HAL_UART_Transmit(huart, &tail, sizeof(tail), 0xFFFF);
     }
-#if SYS_SUPPORT_OS
-    vPortFree(data_buf);
-#else  /* SYS_SUPPORT_OS */
-    free(data_buf);
-#endif /* SYS_SUPPORT_OS */
 }
 
+/**
+ * @brief 在串口 DMA 发送缓冲区中直接组帧, 数据由调用者原地填写
+ *
+ * @param data_mean 数据含义
+ * @param data_type 数据类型
+ * @param data_len 数据长度(字节数)
+ * @return 数据区地址, 填入`data_len`字节后调用`message_send_end`发送.
+ *  @retval NULL - 参数错误, 串口未使用 DMA 发送或者发送缓冲区空间不足
+ * @note 适合高频发送的数据, 省去组帧时的复制. 空间在这里一次分配好,
+ *       其他任务可以同时向同一个串口发送. 必须调用`message_send_end`,
+ *       否则这个串口的发送缓冲区不会再发出
+ */
+void *message_send_begin(message_mean_t data_mean, message_type_t data_type,
+                         size_t data_len) {
+    if (data_len == 0 || data_len > MSG_MAX_DATA_LENGTH) {
+        return NULL;
+    }
+    if (p_send_handle[data_mean] == NULL ||
+        p_send_handle[data_mean]->hdmatx == NULL) {
+        return NULL;
+    }
+
+    uint8_t *frame = uart_dmatx_reserve(p_send_handle[data_mean], data_len + 3);
+    if (frame == NULL) {
+        return NULL;
+    }
+
+    frame[0] = (uint8_t)(data_mean << 4) | data_type;
+    frame[1] = (uint8_t)data_len;
+    frame[data_len + 2] = 0xFF;
+
+    return frame + 2;
+}
+
+/**
+ * @brief 提交`message_send_begin`组好的帧并发送
+ *
+ * @param data_mean 数据含义, 与`message_send_begin`一致
+ * @param data_len 数据长度, 与`message_send_begin`一致
+ */
+void message_send_end(message_mean_t data_mean, size_t data_len) {
+    if (p_send_handle[data_mean] == NULL) {
+        return;
+    }
+
+    uart_dmatx_commit(p_send_handle[data_mean], data_len + 3);
+    uart_dmatx_send(p_send_handle[data_mean]);
+}
+
+/**
+ * @brief 发送 v2 帧, 带序号与 CRC-32 校验
+ *
+ * @param data_mean 数据含义
+ * @param data_type 数据类型
+ * @param data 数据内容
+ * @param data_len 数据长度(字节数), 不超过`MSG_V2_MAX_DATA_LENGTH`
+ * @note 帧格式见`msg_protocol.h`. 接收端用同一个回调函数处理 v1 与 v2 帧.
+ *       使用 DMA 发送时整帧必须能放进串口发送缓冲区, 剩余空间不足时丢弃整帧
+ */
+void message_send_data_v2(message_mean_t data_mean, message_type_t data_type,
+                          const void *data, size_t data_len) {
+    if (data == NULL || data_len == 0) {
+        return;
+    }
+    if (data_len > MSG_V2_MAX_DATA_LENGTH) {
+        return;
+    }
+    if (p_send_handle[data_mean] == NULL) {
+        return;
+    }
+
+    UART_HandleTypeDef *huart = p_send_handle[data_mean];
+
+    /* 同步字, 数据长度, 数据含义, 数据类型, 序号 */
+    uint8_t head[MSG_V2_HEAD_LENGTH] = {
+        MSG_V2_SYNC0,       MSG_V2_SYNC1,       (uint8_t)data_len,
+        (uint8_t)data_mean, (uint8_t)data_type, send_sequence[data_mean]};
+
+    if (huart->hdmatx != NULL) {
+        /* 直接在发送缓冲区中组帧, 整帧连续存放, CRC 一次算完 */
+        size_t frame_len = sizeof(head) + data_len + MSG_V2_CRC_LENGTH;
+        uint8_t *frame = uart_dmatx_reserve(huart, frame_len);
+        if (frame == NULL) {
+            return;
+        }
+
+        memcpy(frame, head, sizeof(head));
+        memcpy(frame + sizeof(head), data, data_len);
+
+        /* 校验从长度字节开始, 不含同步字 */
+        uint32_t crc = crc32_calc(frame + 2, sizeof(head) - 2 + data_len);
+        buffer_schema_store_u32le(frame + sizeof(head) + data_len, crc);
+
+        uart_dmatx_commit(huart, frame_len);
+        uart_dmatx_send(huart);
+    } else {
+        /* 帧头校验部分正好 4 字节, 可以分段计算 */
+        uint32_t crc = crc32_update(CRC32_INIT, head + 2, sizeof(head) - 2);
+        crc = crc32_update(crc, data, data_len);
+
+        uint8_t tail[MSG_V2_CRC_LENGTH];
+        buffer_schema_store_u32le(tail, crc);
+
+        HAL_UART_Transmit(huart, head, sizeof(head), 0xFFFF);
+        HAL_UART_Transmit(huart, (uint8_t *)data, data_len, 0xFFFF);
+        HAL_UART_Transmit(huart, tail, sizeof(tail), 0xFFFF);
+    }
+
+    ++send_sequence[data_mean];
+}
+
+/* 解析器缓冲区长度, 能放下最长的 v1 或 v2 帧 */
+#define MSG_PARSER_BUF_SIZE                                                    \
+    ((MSG_V2_MAX_DATA_LENGTH + MSG_V2_HEAD_LENGTH + MSG_V2_CRC_LENGTH) >       \
+             (MSG_MAX_DATA_LENGTH + 3)                                         \
+         ? (MSG_V2_MAX_DATA_LENGTH + MSG_V2_HEAD_LENGTH + MSG_V2_CRC_LENGTH)   \
+         : (MSG_MAX_DATA_LENGTH + 3))
+
+/**
+ * @brief 流式解析器, 每个轮询的串口一个
+ * @note 缓冲区中保存当前候选帧, 从第一个字节开始就是帧头.
+ *       候选帧出错时丢弃第一个字节, 从下一个字节重新找帧头
+ */
+typedef struct {
+    uint8_t buf[MSG_PARSER_BUF_SIZE];               /*!< 候选帧 */
+    uint16_t count;                                 /*!< 候选帧已接收长度 */
+    bool sequence_valid[MSG_MEAN_LENGTH_RESERVE];   /*!< 已收到过 v2 帧 */
+    uint8_t next_sequence[MSG_MEAN_LENGTH_RESERVE]; /*!< 期望的 v2 帧序号 */
+    message_port_stats_t stats;                     /*!< 统计信息 */
+} msg_parser_t;
+
 /**
  * @brief 消息轮询节点链表
  */
 typedef struct polling_list_node {
     UART_HandleTypeDef *huart;      /*!< 串口句柄 */
+    msg_parser_t parser;            /*!< 流式解析器 */
     struct polling_list_node *next; /*!< 链表下一个节点 */
 } polling_list_node_t;
 
@@ -139,6 +285,7 @@ void message_add_polling_handle(UART_HandleTypeDef *uart_handle) {
     }
 
     new_node->huart = uart_handle;
+    memset(&new_node->parser, 0, sizeof(new_node->parser));
     new_node->next = p_polling_list_head;
     p_polling_list_head = new_node;
 }
@@ -178,17 +325,234 @@ void message_remove_polling_handle(UART_HandleTypeDef *uart_handle) {
 #endif /* SYS_SUPPORT_OS */
 }
 
+/**
+ * @brief 丢弃候选帧开头的字节
+ *
+ * @param parser 解析器
+ * @param len 丢弃的长度
+ */
+static inline void msg_parser_drop(msg_parser_t *parser, uint16_t len) {
+    parser->count -= len;
+    memmove(parser->buf, parser->buf + len, parser->count);
+}
+
+/**
+ * @brief 解析 v1 帧
+ *
+ * @param parser 解析器
+ * @param[out] result 解析结果
+ * @return 是否消耗了数据, `false`表示需要等待更多数据
+ */
+static bool msg_parse_v1(msg_parser_t *parser, uint8_t *result) {
+    uint8_t header = parser->buf[0];
+
+    /* 帧头: 高四位是数据含义, 低四位是数据类型 */
+    if ((header >> 4) >= MSG_MEAN_LENGTH_RESERVE ||
+        (header & 0x0F) > MSG_DATA_STRING) {
+        ++parser->stats.dropped_bytes;
+        msg_parser_drop(parser, 1);
+        return true;
+    }
+
+    if (parser->count < 2) {
+        return false;
+    }
+
+    uint8_t msg_len = parser->buf[1];
+
+    /* 数据长度超过最大长度, 不是合法的帧 */
+    if (msg_len == 0 || msg_len > MSG_MAX_DATA_LENGTH) {
+        ++parser->stats.over_errors;
+        ++parser->stats.dropped_bytes;
+        *result = MSG_DATA_OVER;
+        msg_parser_drop(parser, 1);
+        return true;
+    }
+
+    if (parser->count < msg_len + 3) {
+        return false;
+    }
+
+    /* 校验字节错误, 最后一位不是0xFF */
+    if (parser->buf[msg_len + 2] != 0xFF) {
+        ++parser->stats.verify_errors;
+        ++parser->stats.dropped_bytes;
+        *result = MSG_DATA_VERIFY_ERROR;
+        msg_parser_drop(parser, 1);
+        return true;
+    }
+
+    ++parser->stats.frames;
+    *result = msg_len;
+
+    if (p_receive_callback[header >> 4] != NULL) {
+        p_receive_callback[header >> 4](msg_len, header & 0x0F,
+                                        parser->buf + 2);
+    }
+
+    msg_parser_drop(parser, msg_len + 3);
+    return true;
+}
+
+/**
+ * @brief 解析 v2 帧, 候选帧以同步字开头
+ *
+ * @param parser 解析器
+ * @param[out] result 解析结果
+ * @return 是否消耗了数据, `false`表示需要等待更多数据
+ */
+static bool msg_parse_v2(msg_parser_t *parser, uint8_t *result) {
+    if (parser->count < 3) {
+        return false;
+    }
+
+    uint8_t msg_len = parser->buf[2];
+
+    if (msg_len == 0 || msg_len > MSG_V2_MAX_DATA_LENGTH) {
+        ++parser->stats.over_errors;
+        ++parser->stats.dropped_bytes;
+        *result = MSG_DATA_OVER;
+        msg_parser_drop(parser, 1);
+        return true;
+    }
+
+    uint16_t frame_len = msg_len + MSG_V2_HEAD_LENGTH + MSG_V2_CRC_LENGTH;
+
+    if (parser->count < frame_len) {
+        return false;
+    }
+
+    uint32_t crc =
+        crc32_calc(parser->buf + 2, frame_len - MSG_V2_CRC_LENGTH - 2);
+
+    if (buffer_schema_load_u32le(parser->buf + frame_len -
+                                 MSG_V2_CRC_LENGTH) != crc) {
+        ++parser->stats.crc_errors;
+        ++parser->stats.dropped_bytes;
+        *result = MSG_DATA_CRC_ERROR;
+        msg_parser_drop(parser, 1);
+        return true;
+    }
+
+    uint8_t mean = parser->buf[3];
+    uint8_t type = parser->buf[4];
+    uint8_t sequence = parser->buf[5];
+
+    ++parser->stats.frames;
+    *result = msg_len;
+
+    /* 校验正确但含义未定义, 可能是对方版本较新, 整帧丢弃 */
+    if (mean < MSG_MEAN_LENGTH_RESERVE) {
+        if (parser->sequence_valid[mean] &&
+            sequence != parser->next_sequence[mean]) {
+            parser->stats.lost_frames +=
+                (uint8_t)(sequence - parser->next_sequence[mean]);
+        }
+        parser->sequence_valid[mean] = true;
+        parser->next_sequence[mean] = sequence + 1;
+
+        if (p_receive_callback[mean] != NULL) {
+            p_receive_callback[mean](msg_len, (message_type_t)type,
+                                     parser->buf + MSG_V2_HEAD_LENGTH);
+        }
+    }
+
+    msg_parser_drop(parser, frame_len);
+    return true;
+}
+
+/**
+ * @brief 向解析器输入一个字节, 解析出所有完整的帧并调用回调函数
+ *
+ * @param parser 解析器
+ * @param byte 收到的字节
+ * @param[out] result 解析结果, 收到帧时为消息长度, 出错时为错误标记
+ * @note 以同步字开头的按 v2 帧解析, 否则按 v1 帧解析.
+ *       0xA5 不是合法的 v1 帧头, 两种帧可以在同一个串口上混发
+ */
+static void msg_parser_feed(msg_parser_t *parser, uint8_t byte,
+                            uint8_t *result) {
+    parser->buf[parser->count++] = byte;
+
+    while (parser->count > 0) {
+        bool consumed;
+
+        if (parser->buf[0] == MSG_V2_SYNC0 &&
+            (parser->count < 2 || parser->buf[1] == MSG_V2_SYNC1)) {
+            consumed = msg_parse_v2(parser, result);
+        } else {
+            consumed = msg_parse_v1(parser, result);
+        }
+
+        if (!consumed) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 接收缓冲区被 DMA 覆盖, 丢弃候选帧
+ *
+ * @param parser 解析器
+ */
+static void msg_parser_overrun(msg_parser_t *parser) {
+    ++parser->stats.rx_overruns;
+    parser->stats.dropped_bytes += parser->count;
+    parser->count = 0;
+}
+
+/**
+ * @brief 直接解析 DMA 接收缓冲区中的数据
+ *
+ * @param node 轮询节点
+ * @param[out] result 解析结果
+ * @note 不经过接收 FIFO 和中间数组, 字节直接从 DMA 缓冲区送入解析器.
+ *       解析期间 DMA 覆盖了数据时, 已经调用的回调可能收到错误数据,
+ *       v2 帧有 CRC 保护
+ */
+static void msg_polling_node(polling_list_node_t *node, uint8_t *result) {
+    uart_rx_span_t span;
+    uint8_t res;
+
+    while ((res = uart_dmarx_peek(node->huart, &span)) != 1) {
+        if (res == 2) {
+            msg_parser_overrun(&node->parser);
+        }
+
+        uint32_t data_len = span.len[0] + span.len[1];
+        if (data_len == 0) {
+            return;
+        }
+
+        node->parser.stats.rx_bytes += data_len;
+
+        for (uint8_t i = 0; i < 2; ++i) {
+            for (uint32_t j = 0; j < span.len[i]; ++j) {
+                msg_parser_feed(&node->parser, span.data[i][j], result);
+            }
+        }
+
+        if (uart_dmarx_consume(node->huart, data_len) == 2) {
+            msg_parser_overrun(&node->parser);
+        }
+    }
+}
+
 /**
  * @brief 轮询数据, 并调用相应的函数
  *
  * @return 长度或者状态标记
  *  @retval `0-MSG_NO_DATA` - 没有收到数据, 或者没有接收的串口句柄
  *  @retval `255-MSG_DATA_OVER` - 长度溢出
- *  @retval `254-MSG_DATA_ERROR` - 校验错误, 末尾没有收到0xFF
- *  @retval 1~250 - 本次收到的有效数据
+ *  @retval `253-MSG_DATA_VERIFY_ERROR` - 校验错误, 末尾没有收到0xFF
+ *  @retval `252-MSG_DATA_CRC_ERROR` - v2 帧 CRC 校验错误
+ *  @retval 1~250 - 本次收到的最后一帧的数据长度
  * @note 事先在message_mean_t定义数据类型, 并注册相应的回调函数.
  *       这个函数挂在一个while循环或者定时器中一直轮询就可以,
- *       不要改动这个函数的任何内容
+ *       每次调用轮询一个串口, 处理它已经收到的所有数据.
+ *       使用 RTOS 时推荐用`message_wait_data`代替轮询.
+ *       数据按字节流解析, 一次读到多帧, 或者一帧分多次收到都可以正确处理;
+ *       出错后从下一个字节重新同步, 错误计数见`message_get_port_stats`
  */
 uint8_t message_polling_data(void) {
     /* 轮询链表的指针 */
@@ -199,45 +563,89 @@ uint8_t message_polling_data(void) {
         return MSG_NO_DATA;
     }
 
-    /* 数据数组 */
-    uint8_t data_buf[MSG_MAX_DATA_LENGTH + 3];
-
-    uint32_t data_len =
-        uart_dmarx_read(current_node->huart, data_buf, sizeof(data_buf));
+    uint8_t result = MSG_NO_DATA;
 
+    msg_polling_node(current_node, &result);
     current_node = current_node->next;
 
-    /* 无数据 */
-    if (data_len == 0) {
+    return result;
+}
+
+#if MSG_RX_NOTIFY
+
+/**
+ * @brief 等待接收事件, 并处理所有轮询串口的数据
+ *
+ * @param timeout 最长等待时间, 单位: RTOS tick. `portMAX_DELAY`一直等待
+ * @return 长度或者状态标记, 同`message_polling_data`
+ * @note 串口收到数据 (空闲, DMA 半满或全满中断) 时唤醒调用这个函数的任务,
+ *       不需要周期轮询. 只能有一个任务调用.
+ *       轮询的串口中断与 DMA 接收中断优先级不能高于
+ *       `configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY`
+ */
+uint8_t message_wait_data(uint32_t timeout) {
+    uint8_t result = MSG_NO_DATA;
+
+    if (msg_wait_task == NULL) {
+        /* 第一次调用, 先处理之前已经收到的数据 */
+        msg_wait_task = xTaskGetCurrentTaskHandle();
+    } else if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
         return MSG_NO_DATA;
     }
 
-    uint8_t msg_len = *(data_buf + 1);
-
-    /* 数据长度超过最大长度, 为避免异常内存操作, 直接返回 */
-    if (msg_len > MSG_MAX_DATA_LENGTH) {
-        return MSG_DATA_OVER;
+    for (polling_list_node_t *node = p_polling_list_head; node != NULL;
+         node = node->next) {
+        msg_polling_node(node, &result);
     }
 
-    /* 数据帧中定义的长度与实际接收到的长度不一致 */
-    if (data_len != (msg_len + 3)) {
-        return MSG_DATA_LENGTH_ERROR;
+    return result;
+}
+
+/**
+ * @brief 串口接收事件回调, 唤醒等待接收的任务
+ *
+ * @param huart 串口句柄
+ * @note 在中断中调用. 未轮询的串口收到数据也会唤醒一次, 不影响结果
+ */
+void uart_dmarx_rx_event_callback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+
+    if (msg_wait_task == NULL) {
+        return;
     }
 
-    /* 校验字节错误, 最后一位不是0xFF */
-    if (*(data_buf + msg_len + 2) != 0xFF) {
-        return MSG_DATA_VERIFY_ERROR;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(msg_wait_task, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+#endif /* MSG_RX_NOTIFY */
+
+/**
+ * @brief 读取串口接收统计信息
+ *
+ * @param uart_handle 轮询的串口句柄
+ * @param[out] stats 统计信息
+ * @return 读取结果
+ *  @retval - 0: 成功
+ *  @retval - 1: 参数为空
+ *  @retval - 2: 该串口不在轮询链表中
+ */
+uint8_t message_get_port_stats(UART_HandleTypeDef *uart_handle,
+                               message_port_stats_t *stats) {
+    if (uart_handle == NULL || stats == NULL) {
+        return 1;
     }
 
-    if ((data_buf[0] >> 4) >= MSG_MEAN_LENGTH_RESERVE) {
-        /* 消息下标越界 */
-        return 0;
+    polling_list_node_t *node = p_polling_list_head;
+    while ((node != NULL) && (node->huart != uart_handle)) {
+        node = node->next;
     }
 
-    if (p_receive_callback[(data_buf[0] >> 4)] != NULL) {
-        p_receive_callback[(data_buf[0] >> 4)](msg_len, data_buf[0] & 0x0F,
-                                            data_buf + 2);
+    if (node == NULL) {
+        return 2;
     }
 
-    return (uint8_t)msg_len; /* 返回消息长度 */
+    *stats = node->parser.stats;
+    return 0;
 }
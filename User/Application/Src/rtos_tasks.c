@@ -10,6 +10,7 @@
 #include "uart2_calbackl.h"
 #include "remote_ctrl.h"
 #include "dji_angle.h"
+#include "telemetry.h"
 
 #include "shoot_machine.h"
 
@@ -28,9 +29,13 @@ void task_message(void *pvParameters);
 static TaskHandle_t task_motor_handle; //2006电机控制函数
 void task_motor(void *pvParameters);
 
+static TaskHandle_t task_telemetry_handle; //遥测数据发送
+void task_telemetry(void *pvParameters);
+
 dji_motor_handle_t dji_motor_1; //电机结构体
 pid_t pid_pos;
 pid_t pid_spd;
+static dji_motor_state_t motor_state; //电机反馈, 遥测从这里采样
 
 /*****************************************************************************/
 
@@ -55,11 +60,33 @@ void start_task(void *pvParameters) {
     xTaskCreate(task_message, "task_message", 256, NULL, 2,
                 &task_message_handle);
     xTaskCreate(task_motor, "task_motor", 256, NULL, 2, &task_motor_handle);
+    xTaskCreate(task_telemetry, "task_telemetry", 256, NULL, 1,
+                &task_telemetry_handle);
     Queue_From_Fir = xQueueCreate(1, sizeof(float));
 
     pid_init(&pid_pos, 16384, 5000, 30, 8000, POSITION_PID, 8.0f, 0.001f, 0.0f);
     pid_init(&pid_spd, 8192, 8192, 30, 8000, POSITION_PID, 6.0f, 0.001f, 0.2f);
     dji_motor_init(&dji_motor_1, DJI_M2006, CAN_Motor1_ID, can1_selected);
+    /* 电机 1 kHz 反馈, 连续丢 10 帧认为掉线 */
+    can_list_set_monitor(can1_selected, CAN_ID_STD, CAN_Motor1_ID, 1000, 10);
+
+    /* 遥测通道, 必须在电机任务第一次采样之前添加 */
+    telemetry_add_channel("pos_set", &pid_pos.set[0], TELEMETRY_FLOAT, 100.0f);
+    telemetry_add_channel("pos_get", &pid_pos.get[0], TELEMETRY_FLOAT, 100.0f);
+    telemetry_add_channel("pos_pout", &pid_pos.pout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("pos_iout", &pid_pos.iout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("pos_dout", &pid_pos.dout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("spd_set", &pid_spd.set[0], TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("spd_get", &pid_spd.get[0], TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("spd_pout", &pid_spd.pout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("spd_iout", &pid_spd.iout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("spd_dout", &pid_spd.dout, TELEMETRY_FLOAT, 10.0f);
+    telemetry_add_channel("speed_rpm", &motor_state.speed_rpm, TELEMETRY_INT16,
+                          1.0f);
+    telemetry_add_channel("rotor_deg", &motor_state.rotor_degree,
+                          TELEMETRY_FLOAT, 100.0f);
+    telemetry_add_channel("current", &motor_state.real_current,
+                          TELEMETRY_FLOAT, 1000.0f);
     vTaskDelete(start_task_handle);
     taskEXIT_CRITICAL();
 }
@@ -83,7 +110,7 @@ void task_key(uint8_t key) {
 }
 
 /**
- * @brief Task_message: 指定串口轮询数据函数
+ * @brief Task_message: 等待串口数据并解析消息
  *
  * @param pvParameters Start parameters.
  */
@@ -96,8 +123,7 @@ void task_message(void *pvParameters) {
     remote_register_key_callback(3, task_key);
 
     while (1) {
-        message_polling_data();
-        vTaskDelay(1);
+        message_wait_data(portMAX_DELAY);
     }
 }
 
@@ -116,10 +142,37 @@ void task_motor(void *pvParameters) {
 
         xQueueReceive(Queue_From_Fir, &tartget_angle, 5);
 
-        angle_out = pid_calc(&pid_pos, tartget_angle, dji_motor_1.rotor_degree);
-        speed_out = pid_calc(&pid_spd, angle_out, dji_motor_1.speed_rpm);
+        can_error_poll(can1_selected);
+        can_list_monitor_poll(can1_selected);
+        if (!can_list_node_is_online(can1_selected, CAN_ID_STD,
+                                     CAN_Motor1_ID)) {
+            /* 电机掉线, 停止输出 */
+            dji_motor_set_current(can1_selected, DJI_MOTOR_GROUP1, 0, 0, 0, 0);
+            vTaskDelay(5);
+            continue;
+        }
+
+        /* 角度与速度取自同一帧反馈 */
+        dji_motor_get_state(&dji_motor_1, &motor_state);
+        angle_out = pid_calc(&pid_pos, tartget_angle, motor_state.rotor_degree);
+        speed_out = pid_calc(&pid_spd, angle_out, motor_state.speed_rpm);
         dji_motor_set_current(can1_selected, DJI_MOTOR_GROUP1,
                               (int16_t)speed_out, 0.0, 0.0, 0.0);
+        telemetry_sample();
         vTaskDelay(5);
     }
 }
+
+/**
+ * @brief 遥测任务: 发送电机任务写满的遥测帧
+ *
+ * @param pvParameters Start parameters.
+ */
+void task_telemetry(void *pvParameters) {
+    UNUSED(pvParameters);
+    message_register_send_handle(MSG_TELEMETRY, &usart1_handle);
+
+    while (1) {
+        telemetry_wait_flush(portMAX_DELAY);
+    }
+}
@@ -0,0 +1,303 @@
+/**
+ * @file    telemetry.c
+ * @author  Deadline039
+ * @brief   遥测数据流, 每个控制周期采样一次, 差分编码后经串口发送
+ * @version 1.0
+ * @date    2026-10-18
+ */
+
+#include "telemetry.h"
+#include "buffer_schema.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <math.h>
+#include <string.h>
+
+/* 数据帧头长度: 格式版本, 通道数, 第一个采样的序号, 采样数 */
+#define TELEMETRY_HEAD_LENGTH 5
+/* 一个通道编码后的最大长度 */
+#define TELEMETRY_VARINT_MAX  5
+
+/**
+ * @brief 通道
+ */
+typedef struct {
+    char name[TELEMETRY_NAME_LENGTH + 1]; /*!< 通道名 */
+    const void *source;                   /*!< 数据地址 */
+    telemetry_type_t type;                /*!< 数据类型 */
+    float scale;                          /*!< 浮点数缩放系数 */
+} telemetry_channel_t;
+
+/**
+ * @brief 帧缓冲区
+ */
+typedef struct {
+    uint8_t data[MSG_V2_MAX_DATA_LENGTH]; /*!< 帧数据 */
+    uint8_t len;                          /*!< 帧长度 */
+    volatile bool ready;                  /*!< 写满, 等待发送 */
+} telemetry_buf_t;
+
+static telemetry_channel_t channels[TELEMETRY_MAX_CHANNELS];
+static uint8_t channel_count = 0;
+
+/* 上一采样的整数值, 用于差分 */
+static int32_t last_value[TELEMETRY_MAX_CHANNELS];
+
+/* 双缓冲, 控制任务写一个, 发送任务发另一个 */
+static telemetry_buf_t frame_buf[2];
+static uint8_t fill_index = 0;
+
+static uint16_t sample_index = 0;
+static telemetry_stats_t telemetry_stats = {0};
+
+/* 等待发送的任务 */
+static TaskHandle_t volatile flush_task = NULL;
+
+/**
+ * @brief 添加通道
+ *
+ * @param name 通道名, 超过`TELEMETRY_NAME_LENGTH`会被截断
+ * @param source 数据地址, 采样时读取
+ * @param type 数据类型
+ * @param scale 浮点通道的缩放系数, 决定分辨率; 整数通道忽略
+ * @return 添加结果
+ *  @retval - 0: 成功
+ *  @retval - 1: 参数错误
+ *  @retval - 2: 通道已满
+ * @note 必须在第一次调用`telemetry_sample`之前添加
+ */
+uint8_t telemetry_add_channel(const char *name, const void *source,
+                              telemetry_type_t type, float scale) {
+    if (name == NULL || source == NULL || type > TELEMETRY_INT32) {
+        return 1;
+    }
+
+    if (type == TELEMETRY_FLOAT && !(scale > 0.0f)) {
+        return 1;
+    }
+
+    if (channel_count >= TELEMETRY_MAX_CHANNELS) {
+        return 2;
+    }
+
+    telemetry_channel_t *channel = &channels[channel_count];
+    strncpy(channel->name, name, TELEMETRY_NAME_LENGTH);
+    channel->name[TELEMETRY_NAME_LENGTH] = '\0';
+    channel->source = source;
+    channel->type = type;
+    channel->scale = (type == TELEMETRY_FLOAT) ? scale : 1.0f;
+
+    ++channel_count;
+    return 0;
+}
+
+/**
+ * @brief 读取通道并整数化
+ *
+ * @param channel 通道
+ * @return 整数值
+ */
+static int32_t telemetry_read(const telemetry_channel_t *channel) {
+    switch (channel->type) {
+        case TELEMETRY_FLOAT: {
+            float value = *(const float *)channel->source * channel->scale;
+
+            /* 饱和, NaN 记为 0 */
+            if (value >= 2147483520.0f) {
+                return INT32_MAX;
+            }
+            if (value <= -2147483648.0f) {
+                return INT32_MIN;
+            }
+            if (value != value) {
+                return 0;
+            }
+            return (int32_t)lrintf(value);
+        }
+
+        case TELEMETRY_INT16: {
+            return *(const int16_t *)channel->source;
+        }
+
+        case TELEMETRY_UINT16: {
+            return *(const uint16_t *)channel->source;
+        }
+
+        case TELEMETRY_INT32: {
+            return *(const int32_t *)channel->source;
+        }
+
+        default: {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief 差分值 ZigZag 编码后按 LEB128 写入
+ *
+ * @param buf 写入地址
+ * @param delta 差分值
+ * @return 写入长度
+ */
+static uint8_t telemetry_put_varint(uint8_t *buf, int32_t delta) {
+    uint32_t value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    uint8_t len = 0;
+
+    while (value >= 0x80U) {
+        buf[len++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t)value;
+
+    return len;
+}
+
+/**
+ * @brief 结束当前帧, 交给发送任务
+ *
+ */
+static void telemetry_close_frame(void) {
+    telemetry_buf_t *frame = &frame_buf[fill_index];
+
+    if (frame->len == 0) {
+        return;
+    }
+
+    if (frame_buf[fill_index ^ 1].ready) {
+        /* 上一帧还没有发送, 丢弃这一帧 */
+        ++telemetry_stats.overruns;
+        frame->len = 0;
+        return;
+    }
+
+    frame->ready = true;
+    fill_index ^= 1;
+    frame_buf[fill_index].len = 0;
+
+    if (flush_task != NULL) {
+        xTaskNotifyGive(flush_task);
+    }
+}
+
+/**
+ * @brief 采样所有通道, 编码到当前帧
+ *
+ * @note 在控制任务中每个周期调用一次. 只做编码, 帧写满时通知发送任务,
+ *       不会阻塞
+ */
+void telemetry_sample(void) {
+    if (channel_count == 0) {
+        return;
+    }
+
+    telemetry_buf_t *frame = &frame_buf[fill_index];
+
+    if (frame->len != 0 &&
+        (frame->data[4] >= TELEMETRY_FRAME_SAMPLES ||
+         frame->len + channel_count * TELEMETRY_VARINT_MAX >
+             MSG_V2_MAX_DATA_LENGTH)) {
+        telemetry_close_frame();
+        frame = &frame_buf[fill_index];
+    }
+
+    bool first = (frame->len == 0);
+
+    if (first) {
+        frame->data[0] = TELEMETRY_FORMAT_VERSION;
+        frame->data[1] = channel_count;
+        buffer_schema_store_u16le(frame->data + 2, sample_index);
+        frame->data[4] = 0;
+        frame->len = TELEMETRY_HEAD_LENGTH;
+    }
+
+    for (uint8_t i = 0; i < channel_count; ++i) {
+        int32_t value = telemetry_read(&channels[i]);
+        /* 每帧第一个采样存绝对值 */
+        int32_t delta = first ? value
+                              : (int32_t)((uint32_t)value -
+                                          (uint32_t)last_value[i]);
+
+        frame->len += telemetry_put_varint(frame->data + frame->len, delta);
+        last_value[i] = value;
+    }
+
+    ++frame->data[4];
+    ++sample_index;
+    ++telemetry_stats.samples;
+}
+
+/**
+ * @brief 发送描述帧
+ *
+ */
+static void telemetry_send_descriptor(void) {
+    static uint8_t desc[MSG_V2_MAX_DATA_LENGTH];
+    size_t len = 0;
+
+    desc[len++] = TELEMETRY_FORMAT_VERSION;
+    desc[len++] = channel_count;
+
+    for (uint8_t i = 0; i < channel_count; ++i) {
+        size_t name_len = strlen(channels[i].name) + 1;
+        memcpy(desc + len, channels[i].name, name_len);
+        len += name_len;
+        buffer_schema_store_f32le(desc + len, channels[i].scale);
+        len += 4;
+    }
+
+    message_send_data_v2(MSG_TELEMETRY, MSG_DATA_STRING, desc, len);
+}
+
+/**
+ * @brief 等待写满的帧并发送
+ *
+ * @param timeout 最长等待时间, 单位: RTOS tick
+ * @return 发送的数据帧数
+ * @note 在低优先级任务中循环调用, 只能有一个任务调用
+ */
+uint8_t telemetry_wait_flush(uint32_t timeout) {
+    static uint32_t desc_countdown = 0;
+    uint8_t sent = 0;
+
+    flush_task = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, timeout);
+
+    for (uint8_t i = 0; i < 2; ++i) {
+        telemetry_buf_t *frame = &frame_buf[i];
+
+        if (!frame->ready) {
+            continue;
+        }
+
+        if (desc_countdown == 0) {
+            telemetry_send_descriptor();
+            desc_countdown = TELEMETRY_DESC_PERIOD;
+        }
+        --desc_countdown;
+
+        message_send_data_v2(MSG_TELEMETRY, MSG_DATA_INT32, frame->data,
+                             frame->len);
+        ++telemetry_stats.frames;
+        ++sent;
+
+        frame->ready = false;
+    }
+
+    return sent;
+}
+
+/**
+ * @brief 读取遥测统计信息
+ *
+ * @param[out] stats 统计信息
+ */
+void telemetry_get_stats(telemetry_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    *stats = telemetry_stats;
+}
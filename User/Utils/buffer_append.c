@@ -214,3 +214,95 @@ float uint_to_float(int x_int, float x_min, float x_max, uint8_t bits) {
     }
     return pgg;
 }
+
+void buffer_quant_init(buffer_quant_t *quant, float x_min, float x_max,
+                       uint8_t bits) {
+    if (bits > 16) {
+        bits = 16;
+    }
+
+    quant->offset = x_min;
+    quant->span = x_max - x_min;
+    quant->max_int = BUFFER_QUANT_MAX(bits);
+    quant->scale = quant->max_int / quant->span;
+    quant->inv_max = 1.0f / quant->max_int;
+}
+
+// Sign of (a * max_int - n * span), evaluated exactly with fma error terms
+static inline float quant_residual(const buffer_quant_t *quant, float a,
+                                   float n) {
+    float p = a * quant->max_int;
+    float p_err = fmaf(a, quant->max_int, -p);
+    float s = n * quant->span;
+    float s_err = fmaf(n, quant->span, -s);
+    return (p - s) + (p_err - s_err);
+}
+
+uint16_t buffer_quant_encode(const buffer_quant_t *quant, float x) {
+    float a = x - quant->offset;
+
+    // Saturate, NaN goes to 0
+    if (!(a > 0.0f)) {
+        return 0;
+    }
+    if (a >= quant->span) {
+        return (uint16_t)quant->max_int;
+    }
+
+    // The reciprocal estimate is off by at most one near an integer
+    uint32_t n = (uint32_t)(a * quant->scale);
+    if (quant_residual(quant, a, (float)n) < 0.0f) {
+        --n;
+    } else if (quant_residual(quant, a, (float)(n + 1)) >= 0.0f) {
+        ++n;
+    }
+
+    return (uint16_t)n;
+}
+
+// s + err == a + b exactly
+static inline void quant_two_sum(float a, float b, float *s, float *err) {
+    *s = a + b;
+    float bb = *s - a;
+    *err = (a - (*s - bb)) + (b - bb);
+}
+
+float buffer_quant_decode(const buffer_quant_t *quant, uint16_t x_int) {
+    float x = (float)x_int;
+    if (x > quant->max_int) {
+        x = quant->max_int;
+    }
+
+    // Same float product as uint_to_float, then p / max_int + x_min is
+    // evaluated in extended precision and rounded once. The quotient is
+    // refined twice with exact fma remainders, because x_min may cancel
+    // most of its bits.
+    float p = x * quant->span;
+    float q0 = p * quant->inv_max;
+    float r0 = fmaf(-q0, quant->max_int, p);
+    float q1 = r0 * quant->inv_max;
+    float r1 = fmaf(-q1, quant->max_int, r0);
+    float q2 = r1 * quant->inv_max;
+
+    float s, s_err, t, t_err, u, u_err;
+    quant_two_sum(q0, quant->offset, &s, &s_err);
+    quant_two_sum(s_err, q1, &t, &t_err);
+    quant_two_sum(s, t, &u, &u_err);
+
+    return u + (u_err + (t_err + q2));
+}
+
+void buffer_quant_encode_batch(const buffer_quant_t *quant, const float *x,
+                               uint16_t *x_int, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        x_int[i] = buffer_quant_encode(&quant[i], x[i]);
+    }
+}
+
+void buffer_quant_decode_batch(const buffer_quant_t *quant,
+                               const uint16_t *x_int, float *x,
+                               uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        x[i] = buffer_quant_decode(&quant[i], x_int[i]);
+    }
+}
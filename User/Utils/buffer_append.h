@@ -46,4 +46,46 @@ float buffer_get_float32_auto(const uint8_t *buffer, int32_t *index);
 
 int float_to_uint(float x, float x_min, float x_max, uint8_t bits);
 float uint_to_float(int x_int, float x_min, float x_max, uint8_t bits);
+
+/*
+ * Precomputed quantisation parameters of one field, for float_to_uint and
+ * uint_to_float without the double precision divide (software emulated on
+ * Cortex-M4). Encoding gives the same integer as float_to_uint for every
+ * input inside [x_min, x_max], inputs outside the range saturate to 0 or
+ * (1 << bits) - 1. Decoding is correctly rounded, which equals uint_to_float
+ * except for rare results near 0 that the double path rounds twice.
+ * Do not build this file with -ffast-math or -ffp-contract=fast, the error
+ * terms rely on strict float evaluation.
+ */
+typedef struct {
+    float offset;  // x_min
+    float span;    // x_max - x_min
+    float scale;   // max_int / span, only used as the first estimate
+    float max_int; // (1 << bits) - 1
+    float inv_max; // 1 / max_int
+} buffer_quant_t;
+
+#define BUFFER_QUANT_MAX(bits) ((float)((1UL << (bits)) - 1UL))
+
+// Static initializer, e.g.
+// static const buffer_quant_t q = BUFFER_QUANT_INIT(-12.5f, 12.5f, 16);
+#define BUFFER_QUANT_INIT(x_min, x_max, bits)                                  \
+    {                                                                          \
+        .offset = (float)(x_min),                                              \
+        .span = (float)(x_max) - (float)(x_min),                               \
+        .scale = BUFFER_QUANT_MAX(bits) / ((float)(x_max) - (float)(x_min)),   \
+        .max_int = BUFFER_QUANT_MAX(bits),                                     \
+        .inv_max = 1.0f / BUFFER_QUANT_MAX(bits),                              \
+    }
+
+void buffer_quant_init(buffer_quant_t *quant, float x_min, float x_max,
+                       uint8_t bits);
+uint16_t buffer_quant_encode(const buffer_quant_t *quant, float x);
+float buffer_quant_decode(const buffer_quant_t *quant, uint16_t x_int);
+void buffer_quant_encode_batch(const buffer_quant_t *quant, const float *x,
+                               uint16_t *x_int, uint32_t count);
+void buffer_quant_decode_batch(const buffer_quant_t *quant,
+                               const uint16_t *x_int, float *x,
+                               uint32_t count);
+
 #endif /* __BUFFER_APPEND_H */
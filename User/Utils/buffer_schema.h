@@ -0,0 +1,257 @@
+/**
+ * @file    buffer_schema.h
+ * @author  Deadline039
+ * @brief   编译期帧格式描述, 生成定长帧的打包/解包函数
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    每种帧格式用 X-macro 字段表声明一次, 字段依次排列:
+ *
+ *              #define VESC_STATUS_1(X, s)                                   \
+ *                  X(s, FLOAT, erpm, s32be, 1.0f)                            \
+ *                  X(s, FLOAT, motor_current, s16be, 10.0f)                  \
+ *                  X(s, FLOAT, duty, s16be, 1000.0f)
+ *
+ *              BUFFER_SCHEMA_DEFINE(vesc_status_1, VESC_STATUS_1,
+ *                                   vesc_motor_handle_t)
+ *
+ *          会生成 `vesc_status_1_unpack(buffer, out)`,
+ *          `vesc_status_1_pack(buffer, in)` 以及帧长度 `vesc_status_1_size`.
+ *
+ *          字段类型:
+ *           - FLOAT: 定点数, 解包为 `raw / scale`, 打包为 `value * scale`
+ *           - INT: 整数原样拷贝, 不使用 scale
+ *           - SKIP: 占位 (保留字节), 结构体中不需要对应成员
+ *
+ *          线上格式: s8, u8, s16be, u16be, s32be, u32be, s16le, u16le,
+ *          s32le, u32le, f32be, f32le
+ *
+ *          字段偏移由枚举在编译期算出, 生成的函数没有游标和分支, 每个字段
+ *          是一次非对齐 LDR/STR 加一次 REV (小端字段没有 REV).
+ *          缩放用倒数相乘, 与 `buffer_get_floatxx` 的除法相比最多差 1 LSB.
+ *          同一帧格式中字段名不能重复.
+ */
+
+#ifndef __BUFFER_SCHEMA_H
+#define __BUFFER_SCHEMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "cmsis_compiler.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************
+ * @defgroup 线上格式
+ * @{
+ */
+
+#define BUFFER_SCHEMA_WIDTH_s8    1
+#define BUFFER_SCHEMA_WIDTH_u8    1
+#define BUFFER_SCHEMA_WIDTH_s16be 2
+#define BUFFER_SCHEMA_WIDTH_u16be 2
+#define BUFFER_SCHEMA_WIDTH_s32be 4
+#define BUFFER_SCHEMA_WIDTH_u32be 4
+#define BUFFER_SCHEMA_WIDTH_s16le 2
+#define BUFFER_SCHEMA_WIDTH_u16le 2
+#define BUFFER_SCHEMA_WIDTH_s32le 4
+#define BUFFER_SCHEMA_WIDTH_u32le 4
+#define BUFFER_SCHEMA_WIDTH_f32be 4
+#define BUFFER_SCHEMA_WIDTH_f32le 4
+
+#define BUFFER_SCHEMA_TYPE_s8     int8_t
+#define BUFFER_SCHEMA_TYPE_u8     uint8_t
+#define BUFFER_SCHEMA_TYPE_s16be  int16_t
+#define BUFFER_SCHEMA_TYPE_u16be  uint16_t
+#define BUFFER_SCHEMA_TYPE_s32be  int32_t
+#define BUFFER_SCHEMA_TYPE_u32be  uint32_t
+#define BUFFER_SCHEMA_TYPE_s16le  int16_t
+#define BUFFER_SCHEMA_TYPE_u16le  uint16_t
+#define BUFFER_SCHEMA_TYPE_s32le  int32_t
+#define BUFFER_SCHEMA_TYPE_u32le  uint32_t
+#define BUFFER_SCHEMA_TYPE_f32be  float
+#define BUFFER_SCHEMA_TYPE_f32le  float
+
+/* 以下读写函数默认 CPU 为小端, 且支持非对齐访问 (Cortex-M3/M4/M7) */
+
+static inline int8_t buffer_schema_load_s8(const uint8_t *buffer) {
+    return (int8_t)buffer[0];
+}
+
+static inline uint8_t buffer_schema_load_u8(const uint8_t *buffer) {
+    return buffer[0];
+}
+
+static inline uint16_t buffer_schema_load_u16le(const uint8_t *buffer) {
+    uint16_t value;
+    memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+static inline int16_t buffer_schema_load_s16le(const uint8_t *buffer) {
+    return (int16_t)buffer_schema_load_u16le(buffer);
+}
+
+static inline uint32_t buffer_schema_load_u32le(const uint8_t *buffer) {
+    uint32_t value;
+    memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+static inline int32_t buffer_schema_load_s32le(const uint8_t *buffer) {
+    return (int32_t)buffer_schema_load_u32le(buffer);
+}
+
+static inline uint16_t buffer_schema_load_u16be(const uint8_t *buffer) {
+    return (uint16_t)__REV16(buffer_schema_load_u16le(buffer));
+}
+
+static inline int16_t buffer_schema_load_s16be(const uint8_t *buffer) {
+    return (int16_t)buffer_schema_load_u16be(buffer);
+}
+
+static inline uint32_t buffer_schema_load_u32be(const uint8_t *buffer) {
+    return __REV(buffer_schema_load_u32le(buffer));
+}
+
+static inline int32_t buffer_schema_load_s32be(const uint8_t *buffer) {
+    return (int32_t)buffer_schema_load_u32be(buffer);
+}
+
+static inline float buffer_schema_load_f32le(const uint8_t *buffer) {
+    float value;
+    memcpy(&value, buffer, sizeof(value));
+    return value;
+}
+
+static inline float buffer_schema_load_f32be(const uint8_t *buffer) {
+    uint32_t raw = buffer_schema_load_u32be(buffer);
+    float value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+static inline void buffer_schema_store_s8(uint8_t *buffer, int8_t value) {
+    buffer[0] = (uint8_t)value;
+}
+
+static inline void buffer_schema_store_u8(uint8_t *buffer, uint8_t value) {
+    buffer[0] = value;
+}
+
+static inline void buffer_schema_store_u16le(uint8_t *buffer,
+                                             uint16_t value) {
+    memcpy(buffer, &value, sizeof(value));
+}
+
+static inline void buffer_schema_store_s16le(uint8_t *buffer, int16_t value) {
+    buffer_schema_store_u16le(buffer, (uint16_t)value);
+}
+
+static inline void buffer_schema_store_u32le(uint8_t *buffer,
+                                             uint32_t value) {
+    memcpy(buffer, &value, sizeof(value));
+}
+
+static inline void buffer_schema_store_s32le(uint8_t *buffer, int32_t value) {
+    buffer_schema_store_u32le(buffer, (uint32_t)value);
+}
+
+static inline void buffer_schema_store_u16be(uint8_t *buffer,
+                                             uint16_t value) {
+    buffer_schema_store_u16le(buffer, (uint16_t)__REV16(value));
+}
+
+static inline void buffer_schema_store_s16be(uint8_t *buffer, int16_t value) {
+    buffer_schema_store_u16be(buffer, (uint16_t)value);
+}
+
+static inline void buffer_schema_store_u32be(uint8_t *buffer,
+                                             uint32_t value) {
+    buffer_schema_store_u32le(buffer, __REV(value));
+}
+
+static inline void buffer_schema_store_s32be(uint8_t *buffer, int32_t value) {
+    buffer_schema_store_u32be(buffer, (uint32_t)value);
+}
+
+static inline void buffer_schema_store_f32le(uint8_t *buffer, float value) {
+    memcpy(buffer, &value, sizeof(value));
+}
+
+static inline void buffer_schema_store_f32be(uint8_t *buffer, float value) {
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    buffer_schema_store_u32be(buffer, raw);
+}
+
+/**
+ * @}
+ */
+
+/******************************************************************************
+ * @defgroup 字段展开
+ * @{
+ */
+
+/* 每个字段生成 `<schema>_<name>_pos` 与 `<schema>_<name>_end` 两个枚举 */
+#define BUFFER_SCHEMA_OFFSET_(schema, kind, name, wire, scale)                 \
+    schema##_##name##_pos,                                                     \
+        schema##_##name##_end =                                                \
+            schema##_##name##_pos + BUFFER_SCHEMA_WIDTH_##wire - 1,
+
+#define BUFFER_SCHEMA_UNPACK_(schema, kind, name, wire, scale)                 \
+    BUFFER_SCHEMA_UNPACK_##kind(out->name, buffer + schema##_##name##_pos,     \
+                                wire, scale)
+
+#define BUFFER_SCHEMA_PACK_(schema, kind, name, wire, scale)                   \
+    BUFFER_SCHEMA_PACK_##kind(in->name, buffer + schema##_##name##_pos, wire,  \
+                              scale)
+
+#define BUFFER_SCHEMA_UNPACK_FLOAT(dst, src, wire, scale)                      \
+    (dst) = (float)buffer_schema_load_##wire(src) * (1.0f / (scale));
+#define BUFFER_SCHEMA_UNPACK_INT(dst, src, wire, scale)                        \
+    (dst) = buffer_schema_load_##wire(src);
+#define BUFFER_SCHEMA_UNPACK_SKIP(dst, src, wire, scale)
+
+#define BUFFER_SCHEMA_PACK_FLOAT(src, dst, wire, scale)                        \
+    buffer_schema_store_##wire(                                                \
+        dst, (BUFFER_SCHEMA_TYPE_##wire)((src) * (scale)));
+#define BUFFER_SCHEMA_PACK_INT(src, dst, wire, scale)                          \
+    buffer_schema_store_##wire(dst, (BUFFER_SCHEMA_TYPE_##wire)(src));
+#define BUFFER_SCHEMA_PACK_SKIP(src, dst, wire, scale)                         \
+    memset(dst, 0, BUFFER_SCHEMA_WIDTH_##wire);
+
+/**
+ * @}
+ */
+
+/**
+ * @brief 定义帧格式, 生成帧长度枚举与打包/解包函数
+ *
+ * @param schema 帧格式名, 作为生成的函数与枚举前缀
+ * @param LIST 字段表宏, 形如 `LIST(X, s)`
+ * @param type 字段所在的结构体类型, 结构体成员名与字段名一致
+ */
+#define BUFFER_SCHEMA_DEFINE(schema, LIST, type)                               \
+    enum { LIST(BUFFER_SCHEMA_OFFSET_, schema) schema##_size };                \
+                                                                               \
+    static inline void schema##_unpack(const uint8_t *buffer, type *out) {     \
+        (void)buffer;                                                          \
+        (void)out;                                                             \
+        LIST(BUFFER_SCHEMA_UNPACK_, schema)                                    \
+    }                                                                          \
+                                                                               \
+    static inline void schema##_pack(uint8_t *buffer, const type *in) {        \
+        (void)buffer;                                                          \
+        (void)in;                                                              \
+        LIST(BUFFER_SCHEMA_PACK_, schema)                                      \
+    }
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __BUFFER_SCHEMA_H */
@@ -0,0 +1,46 @@
+/**
+ * @file    crc.h
+ * @author  Deadline039
+ * @brief   CRC 校验
+ * @version 1.1
+ * @date    2026-10-18
+ * @note    CRC-16/CCITT-FALSE: 多项式 0x1021, 初值 0xFFFF, 不反转, 结果不异或.
+ *          查表实现, 每字节一次查表. 数据可以分段计算, 把上一段的结果作为下一段
+ *          的`crc`传入即可.
+ *
+ *          CRC-32 与 STM32 CRC 单元一致: 多项式 0x04C11DB7, 初值 0xFFFFFFFF,
+ *          不反转, 结果不异或. 数据按 32 位小端字处理, 每个字高位先入, 即每 4
+ *          字节按 3, 2, 1, 0 的顺序计算; 末尾不足 4 字节的部分按顺序计算.
+ *          `crc32_calc`在目标板上使用 CRC 单元 (长数据由 DMA 送入), CRC 单元
+ *          被占用或者在主机上编译时使用查表实现, 结果相同.
+ *
+ ******************************************************************************
+ *    Date    | Version |   Author    | Version Info
+ * -----------+---------+-------------+----------------------------------------
+ * 2026-10-18 |   1.0   | Deadline039 | 初版, CRC-16/CCITT-FALSE
+ * 2026-10-18 |   1.1   | Deadline039 | 添加 CRC-32, 硬件 CRC 单元与查表两种实现
+ */
+
+#ifndef __CRC_H
+#define __CRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC16_CCITT_INIT 0xFFFFU     /* CRC-16/CCITT-FALSE 初值 */
+#define CRC32_INIT       0xFFFFFFFFU /* CRC-32 初值 */
+
+uint16_t crc16_ccitt(uint16_t crc, const void *data, size_t len);
+
+uint32_t crc32_calc(const void *data, size_t len);
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __CRC_H */
@@ -2,8 +2,12 @@
  * @file    ring_fifo.c
  * @author  mcdx
  * @brief   环形FIFO
- * @version 1.0
- * @date    2021-10-22
+ * @version 1.1
+ * @date    2026-10-18
+ * @note    单生产者单消费者无锁, 生产者与消费者可以分别在中断和任务中.
+ *          读取对方的指针用 acquire, 更新自己的指针用 release: 生产者先
+ *          写完数据 (帧模式包括帧长) 再发布 tail, 消费者读完数据再发布 head,
+ *          对方看到新指针时一定能看到对应的数据
  */
 
 #include "ring_fifo.h"
@@ -13,6 +17,16 @@
 #define min(a, b)      ((a) > (b) ? (b) : (a))
 #define fifo_max_depth (0xffffffff >> 1)
 
+#if defined(__GNUC__) || defined(__clang__)
+/* armclang, gcc: Cortex-M4 上生成 ldr/str + dmb */
+#define rf_load_acquire(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define rf_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else /* defined(__GNUC__) || defined(__clang__) */
+/* 单核上中断与任务共享只需要阻止编译器重排 */
+#define rf_load_acquire(p)     (*(p))
+#define rf_store_release(p, v) (*(p) = (v))
+#endif /* defined(__GNUC__) || defined(__clang__) */
+
 static inline uint32_t is_pow_of_2(uint32_t n) {
     return (0 != n) && (0 == (n & (n - 1)));
 }
@@ -83,14 +97,17 @@ uint32_t ring_fifo_write(ring_fifo_t *ring, const void *buf, uint32_t len) {
     uint32_t unused;
     uint32_t off, l;
     uint32_t frame_off, skip;
+    /* tail 只有生产者修改, head 由消费者发布 */
+    uint32_t tail = ring->tail;
+    uint32_t head = rf_load_acquire(&ring->head);
 
-    unused = ring->size - (ring->tail - ring->head);
+    unused = ring->size - (tail - head);
     switch (ring->type) {
         case RF_TYPE_FRAME:
             frame_off = sizeof(uint32_t);
             skip = 0;
-            if (ring->size - (ring->tail & ring->mask) < frame_off) {
-                skip = ring->size - (ring->tail & ring->mask);
+            if (ring->size - (tail & ring->mask) < frame_off) {
+                skip = ring->size - (tail & ring->mask);
                 /* 跳过尾部[1, frame_off - 1]字节 */
                 frame_off += skip;
             }
@@ -103,8 +120,8 @@ uint32_t ring_fifo_write(ring_fifo_t *ring, const void *buf, uint32_t len) {
                 return 0;
             }
             /* 写入帧长 */
-            *(uint32_t *)((uint8_t *)ring->buf +
-                          ((ring->tail + skip) & ring->mask)) = wlen;
+            *(uint32_t *)((uint8_t *)ring->buf + ((tail + skip) & ring->mask)) =
+                wlen;
             break;
         default: /* RF_TYPE_STREAM */
             frame_off = 0;
@@ -116,12 +133,13 @@ uint32_t ring_fifo_write(ring_fifo_t *ring, const void *buf, uint32_t len) {
     }
 
     /* 计算写入位置 */
-    off = (ring->tail + frame_off) & ring->mask;
+    off = (tail + frame_off) & ring->mask;
     l = min(wlen, ring->size - off);
     memcpy((uint8_t *)ring->buf + off, buf, l);
     memcpy(ring->buf, (uint8_t *)buf + l, wlen - l);
 
-    ring->tail += wlen + frame_off;
+    /* 帧长与数据写完后再发布 */
+    rf_store_release(&ring->tail, tail + wlen + frame_off);
 
     return wlen;
 }
@@ -131,14 +149,17 @@ uint32_t ring_fifo_read(ring_fifo_t *ring, void *buf, uint32_t len) {
     uint32_t used;
     uint32_t off, l;
     uint32_t frame_off, skip;
+    /* head 只有消费者修改, tail 由生产者发布 */
+    uint32_t head = ring->head;
+    uint32_t tail = rf_load_acquire(&ring->tail);
 
-    used = ring->tail - ring->head;
+    used = tail - head;
     switch (ring->type) {
         case RF_TYPE_FRAME:
             frame_off = sizeof(uint32_t);
             skip = 0;
-            if (ring->size - (ring->head & ring->mask) < frame_off) {
-                skip = ring->size - (ring->head & ring->mask);
+            if (ring->size - (head & ring->mask) < frame_off) {
+                skip = ring->size - (head & ring->mask);
                 /* 跳过尾部[1, frame_off - 1]字节 */
                 frame_off += skip;
             }
@@ -147,7 +168,7 @@ uint32_t ring_fifo_read(ring_fifo_t *ring, void *buf, uint32_t len) {
             }
             /* 读取帧长 */
             rlen = *(uint32_t *)((uint8_t *)ring->buf +
-                                 ((ring->head + skip) & ring->mask));
+                                 ((head + skip) & ring->mask));
             /* 给定的缓冲区小于要读出的帧长 */
             if (len < rlen) {
                 return 0;
@@ -163,28 +184,31 @@ uint32_t ring_fifo_read(ring_fifo_t *ring, void *buf, uint32_t len) {
     }
 
     /* 计算读取位置 */
-    off = (ring->head + frame_off) & ring->mask;
+    off = (head + frame_off) & ring->mask;
     l = min(rlen, ring->size - off);
     memcpy(buf, (uint8_t *)ring->buf + off, l);
     memcpy((uint8_t *)buf + l, ring->buf, rlen - l);
 
-    ring->head += rlen + frame_off;
+    /* 数据读完后再释放空间 */
+    rf_store_release(&ring->head, head + rlen + frame_off);
 
     return rlen;
 }
 
 uint32_t ring_fifo_is_full(ring_fifo_t *ring) {
-    return ring->size == (ring->tail - ring->head);
+    return ring->size == ring_fifo_count(ring);
 }
 
 uint32_t ring_fifo_is_empty(ring_fifo_t *ring) {
-    return ring->tail == ring->head;
+    return 0 == ring_fifo_count(ring);
 }
 
 uint32_t ring_fifo_avail(ring_fifo_t *ring) {
-    return ring->size - (ring->tail - ring->head);
+    return ring->size - ring_fifo_count(ring);
 }
 
 uint32_t ring_fifo_count(ring_fifo_t *ring) {
-    return ring->tail - ring->head;
+    uint32_t head = rf_load_acquire(&ring->head);
+
+    return rf_load_acquire(&ring->tail) - head;
 }
@@ -2,8 +2,11 @@
  * @file    ring_fifo.h
  * @author  mcdx
  * @brief   环形FIFO
- * @version 1.0
- * @date    2021-10-22
+ * @version 1.1
+ * @date    2026-10-18
+ * @note    单生产者单消费者 (SPSC) 无锁: 同一时刻只能有一个上下文写入,
+ *          一个上下文读取, 例如 DMA 中断写入, 任务读取.
+ *          多个写入者或多个读取者需要自行加锁
  */
 
 #ifndef __RING_FIFO_H
@@ -24,8 +27,8 @@ enum ring_fifo_type {
 
 /* 环形缓冲区结构 */
 typedef struct {
-    volatile uint32_t head; /* 消费者指针 */
-    volatile uint32_t tail; /* 生产者指针 */
+    volatile uint32_t head; /* 消费者指针, 只有消费者修改 */
+    volatile uint32_t tail; /* 生产者指针, 只有生产者修改 */
 
     uint32_t size; /* 缓冲区的大小 */
     uint32_t mask; /* 缓冲区的大小掩码 */
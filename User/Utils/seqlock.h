@@ -0,0 +1,97 @@
+/**
+ * @file    seqlock.h
+ * @author  Deadline039
+ * @brief   顺序锁 (seqlock), 用于中断写, 任务读的数据快照
+ * @version 1.0
+ * @date    2026-10-18
+ * @note    只允许一个写者 (通常是 CAN 接收中断), 读者可以有多个.
+ *          写者不会被阻塞; 读者在读取过程中若数据被改写, 重新读取即可,
+ *          不需要关中断. 读者的优先级不能高于写者 (写者为中断时天然满足),
+ *          否则读者可能在写者写到一半时一直自旋.
+ */
+
+#ifndef __SEQLOCK_H
+#define __SEQLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "cmsis_compiler.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief 顺序锁, 序号为奇数表示正在写入
+ */
+typedef struct {
+    volatile uint32_t sequence; /*!< 写入序号 */
+} seqlock_t;
+
+/**
+ * @brief 初始化顺序锁
+ *
+ * @param lock 顺序锁
+ */
+static inline void seqlock_init(seqlock_t *lock) {
+    lock->sequence = 0;
+}
+
+/**
+ * @brief 开始写入, 序号变为奇数
+ *
+ * @param lock 顺序锁
+ */
+static inline void seqlock_write_begin(seqlock_t *lock) {
+    lock->sequence = lock->sequence + 1;
+    __DMB();
+}
+
+/**
+ * @brief 结束写入, 序号变为偶数
+ *
+ * @param lock 顺序锁
+ */
+static inline void seqlock_write_end(seqlock_t *lock) {
+    __DMB();
+    lock->sequence = lock->sequence + 1;
+}
+
+/**
+ * @brief 开始读取, 等待写入完成并返回当前序号
+ *
+ * @param lock 顺序锁
+ * @return 读取开始时的序号
+ */
+static inline uint32_t seqlock_read_begin(const seqlock_t *lock) {
+    uint32_t sequence;
+
+    do {
+        sequence = lock->sequence;
+    } while (sequence & 1U);
+
+    __DMB();
+    return sequence;
+}
+
+/**
+ * @brief 结束读取, 判断读取期间数据是否被改写
+ *
+ * @param lock 顺序锁
+ * @param sequence `seqlock_read_begin` 返回的序号
+ * @return 是否需要重新读取
+ * @retval - true: 数据被改写, 需要重新读取
+ * @retval - false: 读取到的数据是一致的
+ */
+static inline bool seqlock_read_retry(const seqlock_t *lock,
+                                      uint32_t sequence) {
+    __DMB();
+    return (lock->sequence != sequence);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __SEQLOCK_H */